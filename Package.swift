@@ -38,6 +38,17 @@ let package = Package(
                 "cpp-utils"
             ]
         ),
+        .target(
+            name: "cpp-utils-allocation-counter"
+        ),
+        .executableTarget(
+            name: "cpp-utils-benchmarks",
+            dependencies: [
+                "cpp-utils",
+                "observing",
+                "cpp-utils-allocation-counter",
+            ]
+        ),
         .testTarget(
             name: "objc-utils-tests",
             dependencies: [
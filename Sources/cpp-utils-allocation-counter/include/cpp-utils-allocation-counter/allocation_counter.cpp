@@ -0,0 +1,92 @@
+//
+//  allocation_counter.cpp
+//
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace yas::allocation_counter_utils {
+static std::atomic<std::size_t> count = 0;
+
+static void *allocate(std::size_t const size) {
+    ++count;
+
+    if (void *ptr = std::malloc(size > 0 ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+static void *allocate(std::size_t const size, std::align_val_t const alignment) {
+    ++count;
+
+    std::size_t const align = static_cast<std::size_t>(alignment);
+    if (void *ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+}  // namespace yas::allocation_counter_utils
+
+using namespace yas;
+
+std::size_t allocation_counter::count() {
+    return allocation_counter_utils::count;
+}
+
+#pragma mark - replacements
+
+// the array forms are replaced as well, so that every pointer is freed by the function pairing with its allocation.
+
+void *operator new(std::size_t size) {
+    return allocation_counter_utils::allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocation_counter_utils::allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocation_counter_utils::allocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocation_counter_utils::allocate(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
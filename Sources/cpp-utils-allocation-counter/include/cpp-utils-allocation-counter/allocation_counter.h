@@ -0,0 +1,13 @@
+//
+//  allocation_counter.h
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace yas::allocation_counter {
+// the number of allocations by the global operator new, which is replaced by linking this target. it is linked only
+// into the test runner and the benchmarks.
+[[nodiscard]] std::size_t count();
+}  // namespace yas::allocation_counter
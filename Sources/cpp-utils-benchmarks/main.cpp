@@ -0,0 +1,365 @@
+//
+//  main.cpp
+//
+
+#include <cpp-utils-allocation-counter/allocation_counter.h>
+#include <cpp-utils/task_queue.h>
+#include <cpp-utils/worker.h>
+#include <observing/umbrella.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace yas;
+
+namespace yas::benchmark {
+using clock = std::chrono::steady_clock;
+
+struct options {
+    // multiplies the iteration counts. --quick sets it to 0.1.
+    double scale = 1.0;
+    std::string filter;
+};
+
+// a result printed as a line of json, so that the output can be compared between runs by tools.
+struct record {
+    std::string name;
+    std::vector<std::pair<std::string, double>> values;
+
+    void print() const {
+        std::printf("{\"name\":\"%s\"", this->name.c_str());
+        for (auto const &pair : this->values) {
+            std::printf(",\"%s\":%.3f", pair.first.c_str(), pair.second);
+        }
+        std::printf("}\n");
+        std::fflush(stdout);
+    }
+};
+
+static std::size_t scaled(options const &options, std::size_t const count) {
+    return std::max(static_cast<std::size_t>(static_cast<double>(count) * options.scale), std::size_t(1));
+}
+
+static double nanoseconds(clock::duration const &duration) {
+    return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+static double per_second(std::size_t const count, clock::duration const &duration) {
+    return static_cast<double>(count) / std::chrono::duration<double>(duration).count();
+}
+
+// the sample at the ratio of the sorted samples.
+static double percentile(std::vector<double> &samples, double const ratio) {
+    std::sort(samples.begin(), samples.end());
+    auto const idx = static_cast<std::size_t>(ratio * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples.at(idx);
+}
+
+static std::shared_ptr<task<int>> make_task(std::atomic<std::size_t> &executed, std::size_t const idx) {
+    return task<int>::make_shared([&executed](auto const &) { ++executed; },
+                                  {.priority = static_cast<task_priority_t>(idx % 2), .canceller = static_cast<int>(idx)});
+}
+
+#pragma mark - task_queue
+
+static void submit(task_queue<int> &queue, std::atomic<std::size_t> &executed, std::size_t const task_count) {
+    for (std::size_t idx = 0; idx < task_count; ++idx) {
+        queue.push_back(make_task(executed, idx));
+    }
+    queue.wait_until_all_tasks_are_finished();
+}
+
+static record task_queue_submission(options const &options) {
+    std::size_t const batch_size = 1000;
+    std::size_t const batch_count = scaled(options, 100);
+
+    auto const queue = task_queue<int>::make_shared(2);
+    std::atomic<std::size_t> executed = 0;
+
+    // grows the pools and the buffers with a suspended queue, so that all of the tasks of a batch exist at once. the
+    // pools also keep up to the cache capacity on each of the calling thread and the executor thread.
+    std::size_t const warming_count = batch_size + pool_allocator<int>::pool_t::cache_capacity * 2;
+
+    queue->suspend();
+    for (std::size_t idx = 0; idx < warming_count; ++idx) {
+        queue->push_back(make_task(executed, idx));
+    }
+    queue->resume();
+    queue->wait_until_all_tasks_are_finished();
+
+    submit(*queue, executed, batch_size);
+
+    std::size_t const allocation_count = allocation_counter::count();
+    auto const begin = clock::now();
+
+    for (std::size_t idx = 0; idx < batch_count; ++idx) {
+        submit(*queue, executed, batch_size);
+    }
+
+    auto const duration = clock::now() - begin;
+    std::size_t const heap_allocations = allocation_counter::count() - allocation_count;
+    std::size_t const task_count = batch_size * batch_count;
+
+    return record{.name = "task_queue_submission",
+                  .values = {{"tasks", task_count},
+                             {"ns_per_task", nanoseconds(duration) / static_cast<double>(task_count)},
+                             {"heap_allocations", heap_allocations}}};
+}
+
+// pushing to a suspended queue, executing the queued tasks and canceling them are measured separately.
+static record task_queue_throughput(options const &options) {
+    std::size_t const task_count = scaled(options, 100000);
+
+    auto const queue = task_queue<int>::make_shared(2, 4);
+    std::atomic<std::size_t> executed = 0;
+
+    queue->suspend();
+
+    auto const push_begin = clock::now();
+    for (std::size_t idx = 0; idx < task_count; ++idx) {
+        queue->push_back(make_task(executed, idx));
+    }
+    auto const push_duration = clock::now() - push_begin;
+
+    auto const execute_begin = clock::now();
+    queue->resume();
+    queue->wait_until_all_tasks_are_finished();
+    auto const execute_duration = clock::now() - execute_begin;
+
+    queue->suspend();
+    for (std::size_t idx = 0; idx < task_count; ++idx) {
+        queue->push_back(make_task(executed, idx));
+    }
+
+    auto const cancel_begin = clock::now();
+    for (std::size_t idx = 0; idx < task_count; ++idx) {
+        queue->cancel_by_canceller(static_cast<int>(idx));
+    }
+    auto const cancel_duration = clock::now() - cancel_begin;
+
+    queue->resume();
+    queue->wait_until_all_tasks_are_finished();
+
+    return record{.name = "task_queue_throughput",
+                  .values = {{"tasks", task_count},
+                             {"push_per_second", per_second(task_count, push_duration)},
+                             {"execute_per_second", per_second(task_count, execute_duration)},
+                             {"cancel_per_second", per_second(task_count, cancel_duration)}}};
+}
+
+// from push_back() to the start of the execution, one task at a time.
+static record task_queue_dispatch_latency(options const &options) {
+    std::size_t const sample_count = scaled(options, 10000);
+
+    auto const queue = task_queue<int>::make_shared(1, 1);
+    std::vector<double> samples;
+    samples.reserve(sample_count);
+
+    for (std::size_t idx = 0; idx < sample_count; ++idx) {
+        auto const pushed = clock::now();
+        queue->push_back(task<int>::make_shared(
+            [&samples, pushed](auto const &) { samples.push_back(nanoseconds(clock::now() - pushed)); }));
+        queue->wait_until_all_tasks_are_finished();
+    }
+
+    return record{.name = "task_queue_dispatch_latency",
+                  .values = {{"samples", sample_count},
+                             {"p50_ns", percentile(samples, 0.5)},
+                             {"p99_ns", percentile(samples, 0.99)},
+                             {"max_ns", percentile(samples, 1.0)}}};
+}
+
+static record task_queue_contention(options const &options, std::size_t const producer_count) {
+    std::size_t const task_count_per_producer = std::max(scaled(options, 200000) / producer_count, std::size_t(1));
+    std::size_t const task_count = task_count_per_producer * producer_count;
+
+    auto const queue = task_queue<int>::make_shared(2, 4);
+    std::atomic<std::size_t> executed = 0;
+    std::atomic<bool> is_started = false;
+    std::vector<std::thread> producers;
+    producers.reserve(producer_count);
+
+    for (std::size_t producer_idx = 0; producer_idx < producer_count; ++producer_idx) {
+        producers.emplace_back([&queue, &executed, &is_started, task_count_per_producer] {
+            while (!is_started) {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t idx = 0; idx < task_count_per_producer; ++idx) {
+                queue->push_back(make_task(executed, idx));
+            }
+        });
+    }
+
+    auto const begin = clock::now();
+    is_started = true;
+
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    queue->wait_until_all_tasks_are_finished();
+
+    auto const duration = clock::now() - begin;
+
+    return record{.name = "task_queue_contention",
+                  .values = {{"producers", producer_count},
+                             {"tasks", task_count},
+                             {"ns_per_task", nanoseconds(duration) / static_cast<double>(task_count)},
+                             {"tasks_per_second", per_second(task_count, duration)}}};
+}
+
+#pragma mark - worker
+
+// from wake() to the start of the task on a parked worker.
+static record worker_wake_latency(options const &options) {
+    std::size_t const sample_count = scaled(options, 1000);
+
+    auto const worker = worker::make_shared(std::chrono::seconds(1));
+    std::atomic<clock::rep> woken_time = 0;
+    std::atomic<bool> is_recorded = false;
+    std::vector<double> samples;
+    samples.reserve(sample_count);
+
+    worker->add_task(0, [&woken_time, &is_recorded, &samples] {
+        if (auto const time = woken_time.exchange(0); time != 0) {
+            samples.push_back(nanoseconds(clock::now() - clock::time_point(clock::duration(time))));
+            is_recorded = true;
+            return worker_task_result::processed;
+        }
+        return worker_task_result::unprocessed;
+    });
+
+    worker->start();
+
+    for (std::size_t idx = 0; idx < sample_count; ++idx) {
+        // lets the worker run out of spinning and park.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        is_recorded = false;
+        woken_time = clock::now().time_since_epoch().count();
+        worker->wake();
+
+        while (!is_recorded) {
+            std::this_thread::yield();
+        }
+    }
+
+    worker->stop();
+
+    return record{.name = "worker_wake_latency",
+                  .values = {{"samples", sample_count},
+                             {"p50_ns", percentile(samples, 0.5)},
+                             {"p99_ns", percentile(samples, 0.99)},
+                             {"max_ns", percentile(samples, 1.0)}}};
+}
+
+#pragma mark - caller
+
+// calling a caller with the handlers added beforehand. the total number of handler calls is about the same for each
+// handler count.
+static record caller_notify(options const &options, std::size_t const handler_count) {
+    std::size_t const call_count = std::max(scaled(options, 10000000) / handler_count, std::size_t(10));
+
+    auto const caller = observing::caller<int>::make_shared();
+    std::vector<observing::canceller_ptr> cancellers;
+    std::size_t sum = 0;
+
+    for (std::size_t idx = 0; idx < handler_count; ++idx) {
+        cancellers.emplace_back(caller->add([&sum](int const &value) { sum += static_cast<std::size_t>(value); }));
+    }
+
+    caller->call(1);
+
+    std::size_t const allocation_count = allocation_counter::count();
+    auto const begin = clock::now();
+
+    for (std::size_t idx = 0; idx < call_count; ++idx) {
+        caller->call(1);
+    }
+
+    auto const duration = clock::now() - begin;
+    std::size_t const heap_allocations = allocation_counter::count() - allocation_count;
+
+    if (sum != (call_count + 1) * handler_count) {
+        std::fprintf(stderr, "caller_notify - handlers are not called.\n");
+        std::exit(EXIT_FAILURE);
+    }
+
+    return record{.name = "caller_notify",
+                  .values = {{"handlers", handler_count},
+                             {"calls", call_count},
+                             {"ns_per_call", nanoseconds(duration) / static_cast<double>(call_count)},
+                             {"ns_per_handler", nanoseconds(duration) / static_cast<double>(call_count * handler_count)},
+                             {"heap_allocations", heap_allocations}}};
+}
+}  // namespace yas::benchmark
+
+// usage: cpp-utils-benchmarks [--quick] [--filter=<part of a name>]
+// prints a line of json for each benchmark. fails if the submission of task_queue or calling a caller allocates from
+// the heap.
+int main(int argc, char *argv[]) {
+    benchmark::options options;
+
+    for (int idx = 1; idx < argc; ++idx) {
+        std::string const arg = argv[idx];
+
+        if (arg == "--quick") {
+            options.scale = 0.1;
+        } else if (arg.starts_with("--filter=")) {
+            options.filter = arg.substr(std::string("--filter=").size());
+        } else {
+            std::fprintf(stderr, "unknown argument: %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto const is_enabled = [&options](std::string const &name) {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    };
+
+    bool is_succeeded = true;
+
+    if (is_enabled("task_queue_submission")) {
+        auto const record = benchmark::task_queue_submission(options);
+        record.print();
+        is_succeeded = record.values.back().second == 0;
+    }
+
+    if (is_enabled("task_queue_throughput")) {
+        benchmark::task_queue_throughput(options).print();
+    }
+
+    if (is_enabled("task_queue_dispatch_latency")) {
+        benchmark::task_queue_dispatch_latency(options).print();
+    }
+
+    if (is_enabled("task_queue_contention")) {
+        for (std::size_t producer_count = 1; producer_count <= 64; producer_count *= 2) {
+            benchmark::task_queue_contention(options, producer_count).print();
+        }
+    }
+
+    if (is_enabled("worker_wake_latency")) {
+        benchmark::worker_wake_latency(options).print();
+    }
+
+    if (is_enabled("caller_notify")) {
+        for (std::size_t const handler_count : {1, 10, 100, 10000}) {
+            auto const record = benchmark::caller_notify(options, handler_count);
+            record.print();
+            if (record.values.back().second != 0) {
+                is_succeeded = false;
+            }
+        }
+    }
+
+    return is_succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,81 @@
+//
+//  data_portable.cpp
+//
+
+#if !defined(__APPLE__)
+
+#include "data.h"
+
+#include <algorithm>
+
+using namespace yas;
+
+namespace yas::data_copy_utils {
+// the strided copies use cblas on apple platforms. a plain loop is used instead so that no blas is required.
+template <typename T>
+static void copy_strided(std::size_t const length, T const *const src_ptr, std::size_t const src_stride,
+                         T *const dst_ptr, std::size_t const dst_stride) {
+    if (src_stride == 1 && dst_stride == 1) {
+        std::copy_n(src_ptr, length, dst_ptr);
+        return;
+    }
+
+    for (std::size_t idx = 0; idx < length; ++idx) {
+        dst_ptr[idx * dst_stride] = src_ptr[idx * src_stride];
+    }
+}
+
+template <typename T>
+static void copy_linear(data_copy<T> &data_copy) {
+    std::size_t const src_stride = data_copy.src_data.stride;
+    std::size_t const dst_stride = data_copy.dst_data.stride;
+
+    copy_strided(data_copy.length, &data_copy.src_data.ptr[data_copy.src_begin_idx * src_stride], src_stride,
+                 &data_copy.dst_data.ptr[data_copy.dst_begin_idx * dst_stride], dst_stride);
+}
+
+template <typename T>
+static std::size_t copy_cyclical_strided(data_copy<T> &data_copy) {
+    std::size_t const src_stride = data_copy.src_data.stride;
+    std::size_t const dst_stride = data_copy.dst_data.stride;
+    std::size_t const src_length = data_copy.src_data.length;
+    std::size_t const dst_length = data_copy.dst_data.length;
+    std::size_t src_idx = data_copy.src_begin_idx;
+    std::size_t dst_idx = data_copy.dst_begin_idx;
+    std::size_t const src_end_idx = src_idx + data_copy.length;
+
+    while (src_idx < src_end_idx) {
+        std::size_t const copy_length = std::min(src_length - src_idx, dst_length - dst_idx);
+
+        copy_strided(copy_length, &data_copy.src_data.ptr[src_idx * src_stride], src_stride,
+                     &data_copy.dst_data.ptr[dst_idx * dst_stride], dst_stride);
+
+        dst_idx = (dst_idx + copy_length) % dst_length;
+        src_idx = src_idx + copy_length;
+    }
+
+    return dst_idx;
+}
+
+template <>
+void copy(data_copy<float> &data_copy) {
+    copy_linear(data_copy);
+}
+
+template <>
+void copy(data_copy<double> &data_copy) {
+    copy_linear(data_copy);
+}
+
+template <>
+std::size_t copy_cyclical(data_copy<float> &data_copy) {
+    return copy_cyclical_strided(data_copy);
+}
+
+template <>
+std::size_t copy_cyclical(data_copy<double> &data_copy) {
+    return copy_cyclical_strided(data_copy);
+}
+}  // namespace yas::data_copy_utils
+
+#endif
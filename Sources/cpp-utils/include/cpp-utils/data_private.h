@@ -6,6 +6,8 @@
 
 #include <cpp-utils/fast_each.h>
 
+#include <cstring>
+
 namespace yas::data_copy_utils {
 template <typename T>
 void copy(data_copy<T> &data_copy) {
@@ -4,9 +4,10 @@
 
 #include "exception.h"
 
-#include <CoreFoundation/CoreFoundation.h>
+#include "thread.h"
 
 #include <exception>
+#include <stdexcept>
 
 using namespace yas;
 
@@ -15,13 +16,13 @@ void yas::raise_with_reason(std::string const &reason) {
 }
 
 void yas::raise_if_main_thread() {
-    if (CFEqual(CFRunLoopGetCurrent(), CFRunLoopGetMain())) {
+    if (thread::is_main()) {
         throw std::runtime_error("invalid call on main thread.");
     }
 }
 
 void yas::raise_if_sub_thread() {
-    if (!CFEqual(CFRunLoopGetCurrent(), CFRunLoopGetMain())) {
+    if (!thread::is_main()) {
         throw std::runtime_error("invalid call on sub thread.");
     }
 }
@@ -0,0 +1,119 @@
+//
+//  executor.cpp
+//
+
+#include "executor.h"
+
+#include "ring_deque.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace yas;
+
+#pragma mark - executable
+
+void executable::execute(task_priority_t const, execution_f &&execution) {
+    this->execute(std::move(execution));
+}
+
+#pragma mark - resource
+
+struct thread_pool_executor::resource {
+    std::mutex mutex;
+    std::condition_variable condition;
+    ring_deque<execution_f> executions;
+    bool is_continue = true;
+
+    void run() {
+        while (true) {
+            execution_f execution;
+
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+
+                this->condition.wait(lock, [this] { return !this->is_continue || !this->executions.empty(); });
+
+                if (!this->is_continue) {
+                    break;
+                }
+
+                execution = std::move(this->executions.front());
+                this->executions.pop_front();
+            }
+
+            execution();
+        }
+    }
+};
+
+#pragma mark - thread_pool_executor
+
+thread_pool_executor::thread_pool_executor(std::size_t const thread_count)
+    : _resource(std::make_shared<resource>()), _thread_count(thread_count) {
+    if (thread_count == 0) {
+        throw std::invalid_argument("thread_pool_executor - thread_count is zero.");
+    }
+
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        std::thread thread{[resource = this->_resource] { resource->run(); }};
+        thread.detach();
+    }
+}
+
+thread_pool_executor::~thread_pool_executor() {
+    ring_deque<execution_f> executions;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_resource->mutex);
+        this->_resource->is_continue = false;
+        std::swap(executions, this->_resource->executions);
+    }
+
+    this->_resource->condition.notify_all();
+}
+
+void thread_pool_executor::execute(execution_f &&execution) {
+    {
+        std::lock_guard<std::mutex> lock(this->_resource->mutex);
+        this->_resource->executions.emplace_back(std::move(execution));
+    }
+
+    this->_resource->condition.notify_one();
+}
+
+std::size_t thread_pool_executor::thread_count() const {
+    return this->_thread_count;
+}
+
+thread_pool_executor_ptr thread_pool_executor::make_shared(std::size_t const thread_count) {
+    return thread_pool_executor_ptr(new thread_pool_executor{thread_count});
+}
+
+#pragma mark - executor_stub
+
+executor_stub::executor_stub() {
+}
+
+void executor_stub::execute(execution_f &&execution) {
+    this->_executions.emplace_back(std::move(execution));
+}
+
+std::size_t executor_stub::execution_count() const {
+    return this->_executions.size();
+}
+
+void executor_stub::process() {
+    auto executions = std::move(this->_executions);
+    this->_executions.clear();
+
+    for (auto const &execution : executions) {
+        execution();
+    }
+}
+
+executor_stub_ptr executor_stub::make_shared() {
+    return executor_stub_ptr(new executor_stub{});
+}
@@ -0,0 +1,66 @@
+//
+//  executor.h
+//
+
+#pragma once
+
+#include <cpp-utils/small_function.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace yas {
+using task_priority_t = uint32_t;
+
+class thread_pool_executor;
+using thread_pool_executor_ptr = std::shared_ptr<thread_pool_executor>;
+class executor_stub;
+using executor_stub_ptr = std::shared_ptr<executor_stub>;
+
+struct executable {
+    virtual ~executable() = default;
+
+    using execution_f = small_function<void(void)>;
+
+    virtual void execute(execution_f &&) = 0;
+    // a smaller value is a higher priority. an executor without priorities executes it in order.
+    virtual void execute(task_priority_t const, execution_f &&);
+};
+
+using executable_ptr = std::shared_ptr<executable>;
+
+struct thread_pool_executor final : executable {
+    ~thread_pool_executor();
+
+    using executable::execute;
+    void execute(execution_f &&) override;
+
+    [[nodiscard]] std::size_t thread_count() const;
+
+    static thread_pool_executor_ptr make_shared(std::size_t const thread_count = 1);
+
+   private:
+    class resource;
+
+    std::shared_ptr<resource> const _resource;
+    std::size_t const _thread_count;
+
+    thread_pool_executor(std::size_t const thread_count);
+};
+
+struct executor_stub final : executable {
+    using executable::execute;
+    void execute(execution_f &&) override;
+
+    [[nodiscard]] std::size_t execution_count() const;
+    void process();
+
+    static executor_stub_ptr make_shared();
+
+   private:
+    std::vector<execution_f> _executions;
+
+    executor_stub();
+};
+}  // namespace yas
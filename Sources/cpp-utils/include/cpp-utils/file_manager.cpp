@@ -4,8 +4,6 @@
 
 #include "file_manager.h"
 
-#include "cf_utils.h"
-
 using namespace yas;
 
 file_manager::create_dir_result_t file_manager::create_directory_if_not_exists(std::filesystem::path const &path) {
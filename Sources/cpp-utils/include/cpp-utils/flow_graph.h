@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
 
 namespace yas::flow {
@@ -61,9 +62,9 @@ struct waiting_out {
 
     waiting_out_kind kind() const;
 
-    wait<Waiting> wait() const;
+    flow::wait<Waiting> wait() const;
 
-    run<Running, Event> run() const;
+    flow::run<Running, Event> run() const;
 
    private:
     std::shared_ptr<out_impl<flow::wait<Waiting>>> _wait_impl = nullptr;
@@ -81,9 +82,9 @@ struct running_out {
 
     running_out_kind kind() const;
 
-    wait<Waiting> wait() const;
+    flow::wait<Waiting> wait() const;
 
-    run<Running, Event> run() const;
+    flow::run<Running, Event> run() const;
 
    private:
     std::shared_ptr<out_impl<flow::wait<Waiting>>> _wait_impl = nullptr;
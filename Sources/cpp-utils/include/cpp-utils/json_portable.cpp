@@ -0,0 +1,491 @@
+//
+//  json_portable.cpp
+//
+
+#if !defined(__APPLE__)
+
+#include "json.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+using namespace yas;
+
+namespace yas::json_utils {
+static std::size_t constexpr max_depth = 512;
+
+#pragma mark - writer
+
+static void write_string(std::string const &string, std::string &out) {
+    out.push_back('"');
+
+    for (unsigned char const c : string) {
+        switch (c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '/':
+                // escaped as NSJSONSerialization does.
+                out.append("\\/");
+                break;
+            case '\b':
+                out.append("\\b");
+                break;
+            case '\f':
+                out.append("\\f");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (c < 0x20) {
+                    char buffer[7];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out.append(buffer);
+                } else {
+                    out.push_back(static_cast<char>(c));
+                }
+                break;
+        }
+    }
+
+    out.push_back('"');
+}
+
+static bool write_real(double const value, std::string &out) {
+    if (!std::isfinite(value)) {
+        return false;
+    }
+
+    char buffer[32];
+    auto const result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+    std::string_view const text{buffer, static_cast<std::size_t>(result.ptr - buffer)};
+    out.append(text);
+
+    // keeps the value real when it is read back.
+    if (text.find_first_of(".eE") == std::string_view::npos) {
+        out.append(".0");
+    }
+
+    return true;
+}
+
+static bool write_value(json_value const &value, std::string &out, std::size_t const depth) {
+    if (depth > max_depth) {
+        return false;
+    }
+
+    if (value.integer.has_value()) {
+        out.append(std::to_string(value.integer.value()));
+    } else if (value.real.has_value()) {
+        return write_real(value.real.value(), out);
+    } else if (value.string.has_value()) {
+        write_string(value.string.value(), out);
+    } else if (value.map.has_value()) {
+        out.push_back('{');
+
+        bool is_first = true;
+        for (auto const &pair : value.map.value()) {
+            if (pair.second.is_empty()) {
+                continue;
+            }
+
+            if (!is_first) {
+                out.push_back(',');
+            }
+            is_first = false;
+
+            write_string(pair.first, out);
+            out.push_back(':');
+
+            if (!write_value(pair.second, out, depth + 1)) {
+                return false;
+            }
+        }
+
+        out.push_back('}');
+    } else if (value.vector.has_value()) {
+        out.push_back('[');
+
+        bool is_first = true;
+        for (auto const &element : value.vector.value()) {
+            if (element.is_empty()) {
+                continue;
+            }
+
+            if (!is_first) {
+                out.push_back(',');
+            }
+            is_first = false;
+
+            if (!write_value(element, out, depth + 1)) {
+                return false;
+            }
+        }
+
+        out.push_back(']');
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+#pragma mark - parser
+
+struct parser {
+    std::string const &text;
+    std::size_t idx = 0;
+
+    void skip_whitespace() {
+        while (this->idx < this->text.size()) {
+            switch (this->text[this->idx]) {
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                    ++this->idx;
+                    break;
+                default:
+                    return;
+            }
+        }
+    }
+
+    bool consume(char const c) {
+        this->skip_whitespace();
+
+        if (this->idx < this->text.size() && this->text[this->idx] == c) {
+            ++this->idx;
+            return true;
+        }
+        return false;
+    }
+
+    bool consume_literal(std::string_view const literal) {
+        if (this->text.compare(this->idx, literal.size(), literal) == 0) {
+            this->idx += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    bool is_end() {
+        this->skip_whitespace();
+        return this->idx == this->text.size();
+    }
+
+    // returns false if the text is invalid. the value is left empty for null.
+    bool parse_value(json_value &out, std::size_t const depth) {
+        if (depth > max_depth) {
+            return false;
+        }
+
+        this->skip_whitespace();
+
+        if (this->idx >= this->text.size()) {
+            return false;
+        }
+
+        switch (this->text[this->idx]) {
+            case '{':
+                return this->parse_map(out, depth);
+            case '[':
+                return this->parse_vector(out, depth);
+            case '"': {
+                std::string string;
+                if (!this->parse_string(string)) {
+                    return false;
+                }
+                out = json_value{std::move(string)};
+                return true;
+            }
+            case 't':
+                // booleans are read as integers as NSNumber is.
+                if (this->consume_literal("true")) {
+                    out = json_value{int64_t{1}};
+                    return true;
+                }
+                return false;
+            case 'f':
+                if (this->consume_literal("false")) {
+                    out = json_value{int64_t{0}};
+                    return true;
+                }
+                return false;
+            case 'n':
+                return this->consume_literal("null");
+            default:
+                return this->parse_number(out);
+        }
+    }
+
+    bool parse_map(json_value &out, std::size_t const depth) {
+        ++this->idx;
+
+        json_map map;
+
+        if (!this->consume('}')) {
+            while (true) {
+                this->skip_whitespace();
+
+                std::string key;
+                if (!this->parse_string(key) || !this->consume(':')) {
+                    return false;
+                }
+
+                json_value value{std::nullopt};
+                if (!this->parse_value(value, depth + 1)) {
+                    return false;
+                }
+
+                if (!value.is_empty()) {
+                    map.insert_or_assign(std::move(key), std::move(value));
+                }
+
+                if (this->consume('}')) {
+                    break;
+                } else if (!this->consume(',')) {
+                    return false;
+                }
+            }
+        }
+
+        out = json_value{std::move(map)};
+        return true;
+    }
+
+    bool parse_vector(json_value &out, std::size_t const depth) {
+        ++this->idx;
+
+        json_vector vector;
+
+        if (!this->consume(']')) {
+            while (true) {
+                json_value value{std::nullopt};
+                if (!this->parse_value(value, depth + 1)) {
+                    return false;
+                }
+
+                if (!value.is_empty()) {
+                    vector.emplace_back(std::move(value));
+                }
+
+                if (this->consume(']')) {
+                    break;
+                } else if (!this->consume(',')) {
+                    return false;
+                }
+            }
+        }
+
+        out = json_value{std::move(vector)};
+        return true;
+    }
+
+    bool parse_hex4(uint32_t &out) {
+        if (this->idx + 4 > this->text.size()) {
+            return false;
+        }
+
+        auto const *const begin = this->text.data() + this->idx;
+        auto const result = std::from_chars(begin, begin + 4, out, 16);
+        if (result.ec != std::errc{} || result.ptr != begin + 4) {
+            return false;
+        }
+
+        this->idx += 4;
+        return true;
+    }
+
+    static void append_utf8(uint32_t const code_point, std::string &out) {
+        if (code_point < 0x80) {
+            out.push_back(static_cast<char>(code_point));
+        } else if (code_point < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else if (code_point < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    }
+
+    bool parse_unicode_escape(std::string &out) {
+        uint32_t code_point = 0;
+        if (!this->parse_hex4(code_point)) {
+            return false;
+        }
+
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            uint32_t low = 0;
+            if (!this->consume_literal("\\u") || !this->parse_hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+            return false;
+        }
+
+        append_utf8(code_point, out);
+        return true;
+    }
+
+    bool parse_string(std::string &out) {
+        if (this->idx >= this->text.size() || this->text[this->idx] != '"') {
+            return false;
+        }
+        ++this->idx;
+
+        while (this->idx < this->text.size()) {
+            char const c = this->text[this->idx++];
+
+            if (c == '"') {
+                return true;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                return false;
+            } else if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+
+            if (this->idx >= this->text.size()) {
+                return false;
+            }
+
+            switch (this->text[this->idx++]) {
+                case '"':
+                    out.push_back('"');
+                    break;
+                case '\\':
+                    out.push_back('\\');
+                    break;
+                case '/':
+                    out.push_back('/');
+                    break;
+                case 'b':
+                    out.push_back('\b');
+                    break;
+                case 'f':
+                    out.push_back('\f');
+                    break;
+                case 'n':
+                    out.push_back('\n');
+                    break;
+                case 'r':
+                    out.push_back('\r');
+                    break;
+                case 't':
+                    out.push_back('\t');
+                    break;
+                case 'u':
+                    if (!this->parse_unicode_escape(out)) {
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool parse_number(json_value &out) {
+        std::size_t const begin_idx = this->idx;
+        bool is_real = false;
+
+        if (this->idx < this->text.size() && this->text[this->idx] == '-') {
+            ++this->idx;
+        }
+
+        while (this->idx < this->text.size()) {
+            char const c = this->text[this->idx];
+            if (c == '.' || c == 'e' || c == 'E') {
+                is_real = true;
+            } else if (!(c >= '0' && c <= '9') && c != '+' && c != '-') {
+                break;
+            }
+            ++this->idx;
+        }
+
+        auto const *const begin = this->text.data() + begin_idx;
+        auto const *const end = this->text.data() + this->idx;
+
+        if (begin == end) {
+            return false;
+        }
+
+        if (!is_real) {
+            int64_t integer = 0;
+            auto const result = std::from_chars(begin, end, integer);
+            if (result.ec == std::errc{} && result.ptr == end) {
+                out = json_value{integer};
+                return true;
+            } else if (result.ec != std::errc::result_out_of_range) {
+                return false;
+            }
+        }
+
+        // integers out of the range of int64_t are read as reals.
+        double real = 0.0;
+        auto const result = std::from_chars(begin, end, real);
+        if (result.ec != std::errc{} || result.ptr != end) {
+            return false;
+        }
+
+        out = json_value{real};
+        return true;
+    }
+};
+}  // namespace yas::json_utils
+
+std::string yas::to_json_string(json_value const &json_value) {
+    // the top level must be a map or a vector as NSJSONSerialization requires.
+    if (!json_value.map.has_value() && !json_value.vector.has_value()) {
+        return "";
+    }
+
+    std::string result;
+
+    if (!json_utils::write_value(json_value, result, 0)) {
+        return "";
+    }
+
+    return result;
+}
+
+json_value yas::to_json_value(std::string const &string) {
+    json_utils::parser parser{.text = string};
+
+    parser.skip_whitespace();
+
+    if (parser.idx >= string.size() || (string[parser.idx] != '{' && string[parser.idx] != '[')) {
+        return std::nullopt;
+    }
+
+    json_value result{std::nullopt};
+
+    if (!parser.parse_value(result, 0) || !parser.is_end()) {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+#endif
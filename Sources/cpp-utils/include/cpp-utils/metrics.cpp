@@ -0,0 +1,235 @@
+//
+//  metrics.cpp
+//
+
+#include "metrics.h"
+
+#include <bit>
+#include <stdexcept>
+
+using namespace yas;
+
+namespace yas::metrics_utils {
+template <typename T>
+static void update_max(std::atomic<T> &max, T const value) {
+    T current = max.load(std::memory_order_relaxed);
+    while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+static uint64_t to_count(std::chrono::nanoseconds const &duration) {
+    return duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+}
+}  // namespace yas::metrics_utils
+
+#pragma mark - duration_histogram
+
+duration_histogram::duration_histogram() {
+    this->reset();
+}
+
+void duration_histogram::record(std::chrono::nanoseconds const &duration) {
+    uint64_t const value = metrics_utils::to_count(duration);
+
+    this->_counts.at(bucket_index(duration)).fetch_add(1, std::memory_order_relaxed);
+    this->_count.fetch_add(1, std::memory_order_relaxed);
+    this->_total.fetch_add(value, std::memory_order_relaxed);
+    metrics_utils::update_max(this->_max, value);
+}
+
+void duration_histogram::reset() {
+    for (auto &count : this->_counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    this->_count.store(0, std::memory_order_relaxed);
+    this->_total.store(0, std::memory_order_relaxed);
+    this->_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t duration_histogram::count() const {
+    return this->_count.load(std::memory_order_relaxed);
+}
+
+uint64_t duration_histogram::count_at(std::size_t const bucket_idx) const {
+    return this->_counts.at(bucket_idx).load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds duration_histogram::total() const {
+    return std::chrono::nanoseconds(this->_total.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds duration_histogram::max() const {
+    return std::chrono::nanoseconds(this->_max.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds duration_histogram::percentile(double const ratio) const {
+    if (ratio < 0.0 || ratio > 1.0) {
+        throw std::out_of_range("duration_histogram percentile() - ratio is out of range.");
+    }
+
+    uint64_t total_count = 0;
+    for (auto const &count : this->_counts) {
+        total_count += count.load(std::memory_order_relaxed);
+    }
+
+    if (total_count == 0) {
+        return std::chrono::nanoseconds::zero();
+    }
+
+    auto const target = std::max(static_cast<uint64_t>(static_cast<double>(total_count) * ratio + 0.5), uint64_t(1));
+
+    uint64_t accumulated = 0;
+    for (std::size_t idx = 0; idx < bucket_count; ++idx) {
+        accumulated += this->_counts.at(idx).load(std::memory_order_relaxed);
+        if (accumulated >= target) {
+            return std::min(bucket_upper_bound(idx), this->max());
+        }
+    }
+
+    return this->max();
+}
+
+std::size_t duration_histogram::bucket_index(std::chrono::nanoseconds const &duration) {
+    // the bucket at the index has durations less than 2^index nanoseconds.
+    std::size_t const idx = std::bit_width(metrics_utils::to_count(duration));
+    return std::min(idx, bucket_count - 1);
+}
+
+std::chrono::nanoseconds duration_histogram::bucket_upper_bound(std::size_t const bucket_idx) {
+    if (bucket_idx >= bucket_count) {
+        throw std::out_of_range("duration_histogram bucket_upper_bound() - bucket_idx is out of range.");
+    }
+
+    if (bucket_idx == bucket_count - 1) {
+        return std::chrono::nanoseconds::max();
+    }
+
+    return std::chrono::nanoseconds((int64_t(1) << bucket_idx) - 1);
+}
+
+#pragma mark - task_queue_metrics
+
+task_queue_metrics::task_queue_metrics(std::size_t const priority_count) {
+    if (priority_count == 0) {
+        throw std::invalid_argument("task_queue_metrics - priority_count is zero.");
+    }
+
+    for (std::size_t idx = 0; idx < priority_count; ++idx) {
+        this->_waitings.emplace_back(std::make_unique<duration_histogram>());
+        this->_executions.emplace_back(std::make_unique<duration_histogram>());
+    }
+}
+
+duration_histogram const &task_queue_metrics::waiting(std::size_t const priority) const {
+    return *this->_waitings.at(priority);
+}
+
+duration_histogram const &task_queue_metrics::execution(std::size_t const priority) const {
+    return *this->_executions.at(priority);
+}
+
+std::size_t task_queue_metrics::priority_count() const {
+    return this->_waitings.size();
+}
+
+std::size_t task_queue_metrics::queue_depth() const {
+    return this->_queue_depth.load(std::memory_order_relaxed);
+}
+
+std::size_t task_queue_metrics::max_queue_depth() const {
+    return this->_max_queue_depth.load(std::memory_order_relaxed);
+}
+
+uint64_t task_queue_metrics::cancellation_count() const {
+    return this->_cancellation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t task_queue_metrics::expiration_count() const {
+    return this->_expiration_count.load(std::memory_order_relaxed);
+}
+
+uint64_t task_queue_metrics::overflow_count() const {
+    return this->_overflow_count.load(std::memory_order_relaxed);
+}
+
+void task_queue_metrics::record_waiting(std::size_t const priority, std::chrono::nanoseconds const &duration) {
+    this->_waitings.at(priority)->record(duration);
+}
+
+void task_queue_metrics::record_execution(std::size_t const priority, std::chrono::nanoseconds const &duration) {
+    this->_executions.at(priority)->record(duration);
+}
+
+void task_queue_metrics::add_queue_depth(std::size_t const count) {
+    auto const depth = this->_queue_depth.fetch_add(count, std::memory_order_relaxed) + count;
+    metrics_utils::update_max(this->_max_queue_depth, depth);
+}
+
+void task_queue_metrics::subtract_queue_depth(std::size_t const count) {
+    this->_queue_depth.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void task_queue_metrics::add_cancellation_count(std::size_t const count) {
+    this->_cancellation_count.fetch_add(count, std::memory_order_relaxed);
+}
+
+void task_queue_metrics::add_expiration_count(std::size_t const count) {
+    this->_expiration_count.fetch_add(count, std::memory_order_relaxed);
+}
+
+void task_queue_metrics::add_overflow_count(std::size_t const count) {
+    this->_overflow_count.fetch_add(count, std::memory_order_relaxed);
+}
+
+task_queue_metrics_ptr task_queue_metrics::make_shared(std::size_t const priority_count) {
+    return task_queue_metrics_ptr(new task_queue_metrics{priority_count});
+}
+
+#pragma mark - worker_metrics
+
+worker_metrics::worker_metrics() {
+}
+
+uint64_t worker_metrics::processed_count() const {
+    return this->_processed_count.load(std::memory_order_relaxed);
+}
+
+uint64_t worker_metrics::unprocessed_count() const {
+    return this->_unprocessed_count.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds worker_metrics::busy_duration() const {
+    return std::chrono::nanoseconds(this->_busy_duration.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds worker_metrics::idle_duration() const {
+    return std::chrono::nanoseconds(this->_idle_duration.load(std::memory_order_relaxed));
+}
+
+double worker_metrics::busy_ratio() const {
+    double const busy = static_cast<double>(this->_busy_duration.load(std::memory_order_relaxed));
+    double const idle = static_cast<double>(this->_idle_duration.load(std::memory_order_relaxed));
+
+    if (busy + idle == 0.0) {
+        return 0.0;
+    }
+
+    return busy / (busy + idle);
+}
+
+void worker_metrics::record_busy(bool const processed, std::chrono::nanoseconds const &duration) {
+    if (processed) {
+        this->_processed_count.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        this->_unprocessed_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->_busy_duration.fetch_add(metrics_utils::to_count(duration), std::memory_order_relaxed);
+}
+
+void worker_metrics::record_idle(std::chrono::nanoseconds const &duration) {
+    this->_idle_duration.fetch_add(metrics_utils::to_count(duration), std::memory_order_relaxed);
+}
+
+worker_metrics_ptr worker_metrics::make_shared() {
+    return worker_metrics_ptr(new worker_metrics{});
+}
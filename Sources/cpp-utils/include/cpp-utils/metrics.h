@@ -0,0 +1,103 @@
+//
+//  metrics.h
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace yas {
+class task_queue_metrics;
+using task_queue_metrics_ptr = std::shared_ptr<task_queue_metrics>;
+class worker_metrics;
+using worker_metrics_ptr = std::shared_ptr<worker_metrics>;
+
+// counts durations in buckets of powers of two nanoseconds. it can be recorded from any thread without locking.
+struct duration_histogram final {
+    static std::size_t constexpr bucket_count = 40;
+
+    duration_histogram();
+
+    void record(std::chrono::nanoseconds const &);
+    void reset();
+
+    [[nodiscard]] uint64_t count() const;
+    [[nodiscard]] uint64_t count_at(std::size_t const bucket_idx) const;
+    [[nodiscard]] std::chrono::nanoseconds total() const;
+    [[nodiscard]] std::chrono::nanoseconds max() const;
+    // returns the upper bound of the bucket containing the given ratio (0.0 - 1.0) of the records.
+    [[nodiscard]] std::chrono::nanoseconds percentile(double const ratio) const;
+
+    [[nodiscard]] static std::size_t bucket_index(std::chrono::nanoseconds const &);
+    [[nodiscard]] static std::chrono::nanoseconds bucket_upper_bound(std::size_t const bucket_idx);
+
+   private:
+    std::array<std::atomic<uint64_t>, bucket_count> _counts;
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _total;
+    std::atomic<uint64_t> _max;
+};
+
+struct task_queue_metrics final {
+    // from the submission to the start of the execution.
+    [[nodiscard]] duration_histogram const &waiting(std::size_t const priority) const;
+    [[nodiscard]] duration_histogram const &execution(std::size_t const priority) const;
+    [[nodiscard]] std::size_t priority_count() const;
+    [[nodiscard]] std::size_t queue_depth() const;
+    [[nodiscard]] std::size_t max_queue_depth() const;
+    [[nodiscard]] uint64_t cancellation_count() const;
+    // the number of tasks dropped by their deadlines.
+    [[nodiscard]] uint64_t expiration_count() const;
+    // the number of tasks rejected or dropped by the capacity.
+    [[nodiscard]] uint64_t overflow_count() const;
+
+    void record_waiting(std::size_t const priority, std::chrono::nanoseconds const &);
+    void record_execution(std::size_t const priority, std::chrono::nanoseconds const &);
+    void add_queue_depth(std::size_t const);
+    void subtract_queue_depth(std::size_t const);
+    void add_cancellation_count(std::size_t const);
+    void add_expiration_count(std::size_t const);
+    void add_overflow_count(std::size_t const);
+
+    static task_queue_metrics_ptr make_shared(std::size_t const priority_count);
+
+   private:
+    std::vector<std::unique_ptr<duration_histogram>> _waitings;
+    std::vector<std::unique_ptr<duration_histogram>> _executions;
+    std::atomic<std::size_t> _queue_depth = 0;
+    std::atomic<std::size_t> _max_queue_depth = 0;
+    std::atomic<uint64_t> _cancellation_count = 0;
+    std::atomic<uint64_t> _expiration_count = 0;
+    std::atomic<uint64_t> _overflow_count = 0;
+
+    task_queue_metrics(std::size_t const priority_count);
+};
+
+struct worker_metrics final {
+    // the number of times the tasks are processed through and at least one of them is processed or none of them is.
+    [[nodiscard]] uint64_t processed_count() const;
+    [[nodiscard]] uint64_t unprocessed_count() const;
+    [[nodiscard]] std::chrono::nanoseconds busy_duration() const;
+    [[nodiscard]] std::chrono::nanoseconds idle_duration() const;
+    // busy / (busy + idle). 0.0 before any record.
+    [[nodiscard]] double busy_ratio() const;
+
+    void record_busy(bool const processed, std::chrono::nanoseconds const &);
+    void record_idle(std::chrono::nanoseconds const &);
+
+    static worker_metrics_ptr make_shared();
+
+   private:
+    std::atomic<uint64_t> _processed_count = 0;
+    std::atomic<uint64_t> _unprocessed_count = 0;
+    std::atomic<uint64_t> _busy_duration = 0;
+    std::atomic<uint64_t> _idle_duration = 0;
+
+    worker_metrics();
+};
+}  // namespace yas
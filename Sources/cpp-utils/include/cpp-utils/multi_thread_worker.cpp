@@ -0,0 +1,262 @@
+//
+//  multi_thread_worker.cpp
+//
+
+#include "multi_thread_worker.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace yas;
+
+namespace yas::multi_thread_worker_utils {
+static std::size_t constexpr spin_count = 64;
+static std::size_t constexpr yield_count = 16;
+
+struct slot {
+    workable::task_f const task;
+    multi_thread_worker::task_option_t const option;
+    std::atomic<bool> is_running = false;
+    std::atomic<bool> is_completed = false;
+
+    slot(workable::task_f const &task, multi_thread_worker::task_option_t const &option)
+        : task(task), option(option) {
+    }
+
+    bool is_runnable_on(std::size_t const thread_idx) const {
+        return !this->is_completed && (!this->option.thread_index || *this->option.thread_index == thread_idx);
+    }
+
+    // runs the task if no other thread is running it.
+    std::optional<workable::task_result> try_run() {
+        if (this->is_running.exchange(true)) {
+            return std::nullopt;
+        }
+
+        std::optional<workable::task_result> result = std::nullopt;
+
+        if (!this->is_completed) {
+            result = this->task();
+
+            if (*result == workable::task_result::completed) {
+                this->is_completed = true;
+            }
+        }
+
+        this->is_running = false;
+
+        return result;
+    }
+};
+}  // namespace yas::multi_thread_worker_utils
+
+#pragma mark - resource
+
+struct multi_thread_worker::resource {
+    std::vector<std::unique_ptr<multi_thread_worker_utils::slot>> slots;
+    worker_fairness const fairness;
+    std::atomic<bool> is_continue{true};
+    std::atomic<std::size_t> wake_count{0};
+    std::atomic<std::size_t> parked_count{0};
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    resource(std::vector<std::unique_ptr<multi_thread_worker_utils::slot>> &&slots, worker_fairness const fairness)
+        : slots(std::move(slots)), fairness(fairness) {
+    }
+
+    void wake() {
+        ++this->wake_count;
+
+        if (this->parked_count > 0) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->condition.notify_all();
+        }
+    }
+
+    void run(std::size_t const thread_idx, std::chrono::milliseconds const &sleep_duration) {
+        std::size_t cursor = 0;
+        std::size_t credit = 0;
+
+        while (this->is_continue) {
+            std::size_t const wake_count = this->wake_count;
+
+            bool processed = false;
+
+            while (this->is_continue) {
+                processed = (this->fairness == worker_fairness::strict_priority)
+                                ? this->_process_strict_priority(thread_idx)
+                                : this->_process_weighted_round_robin(thread_idx, cursor, credit);
+                if (!processed) {
+                    break;
+                }
+            }
+
+            this->_wait(wake_count, sleep_duration);
+        }
+    }
+
+   private:
+    bool _process_strict_priority(std::size_t const thread_idx) {
+        for (auto const &slot : this->slots) {
+            if (!slot->is_runnable_on(thread_idx)) {
+                continue;
+            }
+
+            if (slot->try_run() == workable::task_result::processed) {
+                std::this_thread::yield();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool _process_weighted_round_robin(std::size_t const thread_idx, std::size_t &cursor, std::size_t &credit) {
+        std::size_t const count = this->slots.size();
+
+        for (std::size_t offset = 0; offset < count; ++offset) {
+            auto const &slot = this->slots.at(cursor);
+
+            bool const processed =
+                slot->is_runnable_on(thread_idx) && slot->try_run() == workable::task_result::processed;
+
+            if (processed && ++credit < slot->option.weight) {
+                return true;
+            }
+
+            cursor = (cursor + 1) % count;
+            credit = 0;
+
+            if (processed) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool _is_waiting_finished(std::size_t const wake_count) const {
+        return !this->is_continue || this->wake_count != wake_count;
+    }
+
+    // spins, yields and then parks until woken or the duration elapses.
+    void _wait(std::size_t const wake_count, std::chrono::milliseconds const &duration) {
+        for (std::size_t idx = 0; idx < multi_thread_worker_utils::spin_count; ++idx) {
+            if (this->_is_waiting_finished(wake_count)) {
+                return;
+            }
+        }
+
+        for (std::size_t idx = 0; idx < multi_thread_worker_utils::yield_count; ++idx) {
+            std::this_thread::yield();
+
+            if (this->_is_waiting_finished(wake_count)) {
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        ++this->parked_count;
+        this->condition.wait_for(lock, duration, [this, wake_count] { return this->_is_waiting_finished(wake_count); });
+        --this->parked_count;
+    }
+};
+
+#pragma mark - multi_thread_worker
+
+multi_thread_worker::multi_thread_worker(std::size_t const thread_count, worker_fairness const fairness,
+                                         std::chrono::milliseconds const &duration)
+    : _thread_count(thread_count), _fairness(fairness), _sleep_duration(duration) {
+    if (thread_count == 0) {
+        throw std::invalid_argument("multi_thread_worker - thread_count is zero.");
+    }
+}
+
+multi_thread_worker::~multi_thread_worker() {
+    this->stop();
+}
+
+void multi_thread_worker::add_task(uint32_t const priority, task_f &&task) {
+    this->add_task(priority, std::move(task), task_option_t{});
+}
+
+void multi_thread_worker::add_task(uint32_t const priority, task_f &&task, task_option_t const &option) {
+    if (this->_resource) {
+        throw std::runtime_error("worker add_task() - already started.");
+    }
+
+    if (option.thread_index && *option.thread_index >= this->_thread_count) {
+        throw std::out_of_range("worker add_task() - thread_index is out of range.");
+    }
+
+    if (option.weight == 0) {
+        throw std::invalid_argument("worker add_task() - weight is zero.");
+    }
+
+    this->_tasks.emplace(priority, std::make_pair(std::move(task), option));
+}
+
+void multi_thread_worker::start() {
+    if (this->_resource) {
+        throw std::runtime_error("worker start() - already started.");
+    }
+
+    if (this->_tasks.size() == 0) {
+        throw std::runtime_error("worker start() - task is empty.");
+    }
+
+    std::vector<std::unique_ptr<multi_thread_worker_utils::slot>> slots;
+    slots.reserve(this->_tasks.size());
+
+    for (auto const &pair : this->_tasks) {
+        slots.emplace_back(std::make_unique<multi_thread_worker_utils::slot>(pair.second.first, pair.second.second));
+    }
+
+    this->_resource = std::make_shared<resource>(std::move(slots), this->_fairness);
+
+    for (std::size_t idx = 0; idx < this->_thread_count; ++idx) {
+        std::thread thread{[resource = this->_resource, idx, sleep_duration = this->_sleep_duration] {
+            resource->run(idx, sleep_duration);
+        }};
+
+        thread.detach();
+    }
+}
+
+void multi_thread_worker::stop() {
+    if (this->_resource) {
+        this->_resource->is_continue = false;
+        this->_resource->wake();
+        this->_resource = nullptr;
+    }
+}
+
+void multi_thread_worker::wake() {
+    if (this->_resource) {
+        this->_resource->wake();
+    }
+}
+
+std::size_t multi_thread_worker::thread_count() const {
+    return this->_thread_count;
+}
+
+worker_fairness multi_thread_worker::fairness() const {
+    return this->_fairness;
+}
+
+multi_thread_worker_ptr multi_thread_worker::make_shared(std::size_t const thread_count,
+                                                         worker_fairness const fairness) {
+    return multi_thread_worker::make_shared(thread_count, fairness, std::chrono::milliseconds{10});
+}
+
+multi_thread_worker_ptr multi_thread_worker::make_shared(std::size_t const thread_count,
+                                                         worker_fairness const fairness,
+                                                         std::chrono::milliseconds const &duration) {
+    return multi_thread_worker_ptr(new multi_thread_worker{thread_count, fairness, duration});
+}
@@ -0,0 +1,61 @@
+//
+//  multi_thread_worker.h
+//
+
+#pragma once
+
+#include <cpp-utils/worker.h>
+
+#include <chrono>
+#include <map>
+#include <optional>
+
+namespace yas {
+class multi_thread_worker;
+using multi_thread_worker_ptr = std::shared_ptr<multi_thread_worker>;
+
+enum class worker_fairness {
+    // runs the highest priority task again after a task is processed.
+    strict_priority,
+    // runs a task up to its weight times in a row and then moves on to the next task.
+    weighted_round_robin,
+};
+
+struct multi_thread_worker_task_option_t {
+    // the index of the only thread to run the task. any thread runs it if nullopt.
+    std::optional<std::size_t> thread_index = std::nullopt;
+    std::size_t weight = 1;
+};
+
+// a workable that runs its tasks on multiple threads. a task is never run on two threads at once.
+struct multi_thread_worker final : workable {
+    using task_option_t = multi_thread_worker_task_option_t;
+
+    ~multi_thread_worker();
+
+    void add_task(uint32_t const priority, task_f &&) override;
+    void add_task(uint32_t const priority, task_f &&, task_option_t const &);
+    void start() override;
+    void stop() override;
+    void wake() override;
+
+    [[nodiscard]] std::size_t thread_count() const;
+    [[nodiscard]] worker_fairness fairness() const;
+
+    static multi_thread_worker_ptr make_shared(std::size_t const thread_count,
+                                               worker_fairness const = worker_fairness::strict_priority);
+    static multi_thread_worker_ptr make_shared(std::size_t const thread_count, worker_fairness const,
+                                               std::chrono::milliseconds const &);
+
+   private:
+    class resource;
+
+    std::size_t const _thread_count;
+    worker_fairness const _fairness;
+    std::chrono::milliseconds const _sleep_duration;
+    std::multimap<uint32_t, std::pair<task_f, task_option_t>> _tasks;
+    std::shared_ptr<resource> _resource = nullptr;
+
+    multi_thread_worker(std::size_t const thread_count, worker_fairness const, std::chrono::milliseconds const &);
+};
+}  // namespace yas
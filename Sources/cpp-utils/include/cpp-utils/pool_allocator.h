@@ -0,0 +1,76 @@
+//
+//  pool_allocator.h
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace yas {
+// a process-wide pool of fixed size blocks. freed blocks are kept for reuse and never returned to the heap.
+// each thread allocates from and frees to a cache of its own. an empty cache takes a batch of the blocks shared by all
+// threads, and a cache over its capacity gives the surplus back to them, so that no thread keeps more than the capacity.
+template <std::size_t Size, std::size_t Alignment>
+struct block_pool final {
+    static constexpr std::size_t cache_capacity = 64;
+    static constexpr std::size_t refill_count = cache_capacity / 2;
+
+    void *allocate();
+    void deallocate(void *) noexcept;
+
+    // the number of blocks allocated from the heap.
+    [[nodiscard]] std::size_t heap_block_count() const;
+
+    static block_pool &shared();
+
+   private:
+    struct node {
+        node *next;
+    };
+
+    struct cache {
+        node *head = nullptr;
+        std::size_t count = 0;
+        // blocks freed by other thread local objects after the cache is destroyed go to the shared blocks directly.
+        bool is_destroyed = false;
+
+        ~cache();
+    };
+
+    static constexpr std::size_t _block_size = Size < sizeof(node) ? sizeof(node) : Size;
+    static constexpr std::size_t _block_alignment = Alignment < alignof(node) ? alignof(node) : Alignment;
+
+    // the blocks shared by all threads. it is locked only once for a batch of blocks.
+    std::mutex _mutex;
+    node *_freed = nullptr;
+    std::atomic<std::size_t> _heap_block_count = 0;
+
+    block_pool();
+
+    static cache &_cache();
+    void _refill(cache &);
+    void _push_freed(node *first, node *last) noexcept;
+};
+
+template <typename T>
+struct pool_allocator final {
+    using value_type = T;
+    using pool_t = block_pool<sizeof(T), alignof(T)>;
+
+    pool_allocator() noexcept;
+    template <typename U>
+    pool_allocator(pool_allocator<U> const &) noexcept;
+
+    [[nodiscard]] T *allocate(std::size_t const);
+    void deallocate(T *, std::size_t const) noexcept;
+
+    template <typename U>
+    bool operator==(pool_allocator<U> const &) const noexcept;
+    template <typename U>
+    bool operator!=(pool_allocator<U> const &) const noexcept;
+};
+}  // namespace yas
+
+#include "pool_allocator_private.h"
@@ -0,0 +1,167 @@
+//
+//  pool_allocator_private.h
+//
+
+#pragma once
+
+#include <new>
+
+namespace yas {
+template <std::size_t Size, std::size_t Alignment>
+block_pool<Size, Alignment>::block_pool() {
+}
+
+template <std::size_t Size, std::size_t Alignment>
+block_pool<Size, Alignment>::cache::~cache() {
+    if (this->head) {
+        node *last = this->head;
+        while (last->next) {
+            last = last->next;
+        }
+        block_pool::shared()._push_freed(this->head, last);
+    }
+
+    this->head = nullptr;
+    this->count = 0;
+    this->is_destroyed = true;
+}
+
+template <std::size_t Size, std::size_t Alignment>
+void *block_pool<Size, Alignment>::allocate() {
+    auto &cache = _cache();
+
+    if (!cache.head && !cache.is_destroyed) {
+        this->_refill(cache);
+    }
+
+    if (auto *const block = cache.head) {
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    ++this->_heap_block_count;
+    return ::operator new(_block_size, std::align_val_t{_block_alignment});
+}
+
+template <std::size_t Size, std::size_t Alignment>
+void block_pool<Size, Alignment>::deallocate(void *ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    auto *const block = static_cast<node *>(ptr);
+    auto &cache = _cache();
+
+    if (cache.is_destroyed) {
+        this->_push_freed(block, block);
+        return;
+    }
+
+    block->next = cache.head;
+    cache.head = block;
+    ++cache.count;
+
+    if (cache.count > cache_capacity) {
+        // the recently freed blocks at the head are given back, and the blocks for a refill are kept.
+        std::size_t const surplus_count = cache.count - refill_count;
+        node *last = cache.head;
+        for (std::size_t idx = 1; idx < surplus_count; ++idx) {
+            last = last->next;
+        }
+
+        auto *const first = cache.head;
+        cache.head = last->next;
+        cache.count = refill_count;
+        this->_push_freed(first, last);
+    }
+}
+
+template <std::size_t Size, std::size_t Alignment>
+std::size_t block_pool<Size, Alignment>::heap_block_count() const {
+    return this->_heap_block_count;
+}
+
+template <std::size_t Size, std::size_t Alignment>
+block_pool<Size, Alignment> &block_pool<Size, Alignment>::shared() {
+    // never destroyed, because detached threads may free blocks while the process exits.
+    static auto *const pool = new block_pool{};
+    return *pool;
+}
+
+template <std::size_t Size, std::size_t Alignment>
+typename block_pool<Size, Alignment>::cache &block_pool<Size, Alignment>::_cache() {
+    thread_local cache cache;
+    return cache;
+}
+
+template <std::size_t Size, std::size_t Alignment>
+void block_pool<Size, Alignment>::_refill(cache &cache) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (!this->_freed) {
+        return;
+    }
+
+    node *last = this->_freed;
+    std::size_t count = 1;
+    while (count < refill_count && last->next) {
+        last = last->next;
+        ++count;
+    }
+
+    cache.head = this->_freed;
+    cache.count = count;
+    this->_freed = last->next;
+    last->next = nullptr;
+}
+
+template <std::size_t Size, std::size_t Alignment>
+void block_pool<Size, Alignment>::_push_freed(node *first, node *last) noexcept {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    last->next = this->_freed;
+    this->_freed = first;
+}
+
+#pragma mark - pool_allocator
+
+template <typename T>
+pool_allocator<T>::pool_allocator() noexcept {
+}
+
+template <typename T>
+template <typename U>
+pool_allocator<T>::pool_allocator(pool_allocator<U> const &) noexcept {
+}
+
+template <typename T>
+T *pool_allocator<T>::allocate(std::size_t const count) {
+    if (count == 1) {
+        return static_cast<T *>(pool_t::shared().allocate());
+    } else {
+        return static_cast<T *>(::operator new(sizeof(T) * count, std::align_val_t{alignof(T)}));
+    }
+}
+
+template <typename T>
+void pool_allocator<T>::deallocate(T *ptr, std::size_t const count) noexcept {
+    if (count == 1) {
+        pool_t::shared().deallocate(ptr);
+    } else {
+        ::operator delete(ptr, std::align_val_t{alignof(T)});
+    }
+}
+
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator==(pool_allocator<U> const &) const noexcept {
+    return true;
+}
+
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator!=(pool_allocator<U> const &) const noexcept {
+    return false;
+}
+}  // namespace yas
@@ -0,0 +1,78 @@
+//
+//  ring_deque.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace yas {
+// a double-ended queue on a circular buffer. the buffer grows but never shrinks, so a deque in a steady state does not
+// allocate. T must be default constructible. a popped slot is reset to T{}.
+template <typename T>
+struct ring_deque final {
+    template <typename Deque, typename Value>
+    struct iterator_t {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        reference operator*() const;
+        pointer operator->() const;
+        iterator_t &operator++();
+        iterator_t operator++(int);
+        bool operator==(iterator_t const &) const;
+        bool operator!=(iterator_t const &) const;
+
+        Deque *deque;
+        std::size_t index;
+    };
+
+    using iterator = iterator_t<ring_deque, T>;
+    using const_iterator = iterator_t<ring_deque const, T const>;
+
+    ring_deque();
+    explicit ring_deque(std::size_t const capacity);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const;
+
+    T &at(std::size_t const);
+    T const &at(std::size_t const) const;
+    T &front();
+    T const &front() const;
+    T &back();
+    T const &back() const;
+
+    template <typename... Args>
+    T &emplace_back(Args &&...);
+    template <typename... Args>
+    T &emplace_front(Args &&...);
+    void pop_front();
+    void pop_back();
+    void clear();
+
+    template <typename P>
+    std::size_t erase_if(P predicate);
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+   private:
+    std::vector<T> _buffer;
+    std::size_t _head = 0;
+    std::size_t _size = 0;
+
+    std::size_t _buffer_index(std::size_t const) const;
+    void _reserve_one();
+};
+}  // namespace yas
+
+#include "ring_deque_private.h"
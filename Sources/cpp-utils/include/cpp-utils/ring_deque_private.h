@@ -0,0 +1,232 @@
+//
+//  ring_deque_private.h
+//
+
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+
+namespace yas {
+template <typename T>
+template <typename Deque, typename Value>
+typename ring_deque<T>::template iterator_t<Deque, Value>::reference
+ring_deque<T>::iterator_t<Deque, Value>::operator*() const {
+    return this->deque->_buffer[this->deque->_buffer_index(this->index)];
+}
+
+template <typename T>
+template <typename Deque, typename Value>
+typename ring_deque<T>::template iterator_t<Deque, Value>::pointer
+ring_deque<T>::iterator_t<Deque, Value>::operator->() const {
+    return &**this;
+}
+
+template <typename T>
+template <typename Deque, typename Value>
+typename ring_deque<T>::template iterator_t<Deque, Value> &ring_deque<T>::iterator_t<Deque, Value>::operator++() {
+    ++this->index;
+    return *this;
+}
+
+template <typename T>
+template <typename Deque, typename Value>
+typename ring_deque<T>::template iterator_t<Deque, Value> ring_deque<T>::iterator_t<Deque, Value>::operator++(int) {
+    auto copied = *this;
+    ++this->index;
+    return copied;
+}
+
+template <typename T>
+template <typename Deque, typename Value>
+bool ring_deque<T>::iterator_t<Deque, Value>::operator==(iterator_t const &rhs) const {
+    return this->deque == rhs.deque && this->index == rhs.index;
+}
+
+template <typename T>
+template <typename Deque, typename Value>
+bool ring_deque<T>::iterator_t<Deque, Value>::operator!=(iterator_t const &rhs) const {
+    return !(*this == rhs);
+}
+
+template <typename T>
+ring_deque<T>::ring_deque() {
+}
+
+template <typename T>
+ring_deque<T>::ring_deque(std::size_t const capacity) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    this->_buffer.resize(rounded);
+}
+
+template <typename T>
+bool ring_deque<T>::empty() const {
+    return this->_size == 0;
+}
+
+template <typename T>
+std::size_t ring_deque<T>::size() const {
+    return this->_size;
+}
+
+template <typename T>
+std::size_t ring_deque<T>::capacity() const {
+    return this->_buffer.size();
+}
+
+template <typename T>
+T &ring_deque<T>::at(std::size_t const idx) {
+    if (idx >= this->_size) {
+        throw std::out_of_range("ring_deque at() - out of range.");
+    }
+    return this->_buffer[this->_buffer_index(idx)];
+}
+
+template <typename T>
+T const &ring_deque<T>::at(std::size_t const idx) const {
+    if (idx >= this->_size) {
+        throw std::out_of_range("ring_deque at() - out of range.");
+    }
+    return this->_buffer[this->_buffer_index(idx)];
+}
+
+template <typename T>
+T &ring_deque<T>::front() {
+    return this->_buffer[this->_head];
+}
+
+template <typename T>
+T const &ring_deque<T>::front() const {
+    return this->_buffer[this->_head];
+}
+
+template <typename T>
+T &ring_deque<T>::back() {
+    return this->_buffer[this->_buffer_index(this->_size - 1)];
+}
+
+template <typename T>
+T const &ring_deque<T>::back() const {
+    return this->_buffer[this->_buffer_index(this->_size - 1)];
+}
+
+template <typename T>
+template <typename... Args>
+T &ring_deque<T>::emplace_back(Args &&...args) {
+    this->_reserve_one();
+
+    auto &value = this->_buffer[this->_buffer_index(this->_size)];
+    value = T(std::forward<Args>(args)...);
+    ++this->_size;
+    return value;
+}
+
+template <typename T>
+template <typename... Args>
+T &ring_deque<T>::emplace_front(Args &&...args) {
+    this->_reserve_one();
+
+    this->_head = (this->_head + this->_buffer.size() - 1) & (this->_buffer.size() - 1);
+    auto &value = this->_buffer[this->_head];
+    value = T(std::forward<Args>(args)...);
+    ++this->_size;
+    return value;
+}
+
+template <typename T>
+void ring_deque<T>::pop_front() {
+    if (this->_size == 0) {
+        throw std::out_of_range("ring_deque pop_front() - empty.");
+    }
+
+    this->_buffer[this->_head] = T{};
+    this->_head = (this->_head + 1) & (this->_buffer.size() - 1);
+    --this->_size;
+}
+
+template <typename T>
+void ring_deque<T>::pop_back() {
+    if (this->_size == 0) {
+        throw std::out_of_range("ring_deque pop_back() - empty.");
+    }
+
+    this->_buffer[this->_buffer_index(this->_size - 1)] = T{};
+    --this->_size;
+}
+
+template <typename T>
+void ring_deque<T>::clear() {
+    while (this->_size > 0) {
+        this->pop_back();
+    }
+    this->_head = 0;
+}
+
+template <typename T>
+template <typename P>
+std::size_t ring_deque<T>::erase_if(P predicate) {
+    std::size_t kept = 0;
+
+    for (std::size_t idx = 0; idx < this->_size; ++idx) {
+        auto &value = this->_buffer[this->_buffer_index(idx)];
+        if (!predicate(value)) {
+            if (kept != idx) {
+                this->_buffer[this->_buffer_index(kept)] = std::move(value);
+            }
+            ++kept;
+        }
+    }
+
+    std::size_t const erased = this->_size - kept;
+
+    while (this->_size > kept) {
+        this->pop_back();
+    }
+
+    return erased;
+}
+
+template <typename T>
+typename ring_deque<T>::iterator ring_deque<T>::begin() {
+    return iterator{.deque = this, .index = 0};
+}
+
+template <typename T>
+typename ring_deque<T>::iterator ring_deque<T>::end() {
+    return iterator{.deque = this, .index = this->_size};
+}
+
+template <typename T>
+typename ring_deque<T>::const_iterator ring_deque<T>::begin() const {
+    return const_iterator{.deque = this, .index = 0};
+}
+
+template <typename T>
+typename ring_deque<T>::const_iterator ring_deque<T>::end() const {
+    return const_iterator{.deque = this, .index = this->_size};
+}
+
+template <typename T>
+std::size_t ring_deque<T>::_buffer_index(std::size_t const idx) const {
+    return (this->_head + idx) & (this->_buffer.size() - 1);
+}
+
+template <typename T>
+void ring_deque<T>::_reserve_one() {
+    if (this->_size < this->_buffer.size()) {
+        return;
+    }
+
+    std::vector<T> buffer(this->_buffer.empty() ? 16 : this->_buffer.size() * 2);
+
+    for (std::size_t idx = 0; idx < this->_size; ++idx) {
+        buffer[idx] = std::move(this->_buffer[this->_buffer_index(idx)]);
+    }
+
+    this->_buffer = std::move(buffer);
+    this->_head = 0;
+}
+}  // namespace yas
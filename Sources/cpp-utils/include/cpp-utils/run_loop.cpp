@@ -0,0 +1,200 @@
+//
+//  run_loop.cpp
+//
+
+#include "run_loop.h"
+
+#include "pool_allocator.h"
+
+#include <mutex>
+#include <stdexcept>
+
+using namespace yas;
+
+namespace yas::run_loop_utils {
+struct node {
+    run_loop::execution_f execution;
+    node *next = nullptr;
+};
+
+// nodes are allocated from the pool so that posting does not allocate in a steady state.
+static node *make_node(run_loop::execution_f &&execution) {
+    auto *const node = pool_allocator<run_loop_utils::node>{}.allocate(1);
+    new (node) run_loop_utils::node{std::move(execution)};
+    return node;
+}
+
+static void destroy(node *const node) {
+    node->~node();
+    pool_allocator<run_loop_utils::node>{}.deallocate(node, 1);
+}
+
+// puts the nodes left by a throwing execution back under the posted ones, so that they are performed first next time.
+static void restore(std::atomic<node *> &head, node *remaining) {
+    if (!remaining) {
+        return;
+    }
+
+    // the stack is in reverse order of posting.
+    node *first = nullptr;
+    node *last = remaining;
+    while (remaining) {
+        auto *const next = remaining->next;
+        remaining->next = first;
+        first = remaining;
+        remaining = next;
+    }
+
+    if (auto *const posted = head.exchange(nullptr)) {
+        auto *posted_last = posted;
+        while (posted_last->next) {
+            posted_last = posted_last->next;
+        }
+        posted_last->next = first;
+        first = posted;
+    }
+
+    auto *current = head.load();
+    do {
+        last->next = current;
+    } while (!head.compare_exchange_weak(current, first));
+}
+
+static std::thread::id const main_thread_id = std::this_thread::get_id();
+
+struct main_holder {
+    std::mutex mutex;
+    run_loop_ptr loop = nullptr;
+};
+
+static main_holder &shared_main_holder() {
+    static main_holder holder;
+    return holder;
+}
+}  // namespace yas::run_loop_utils
+
+run_loop::run_loop(std::thread::id const &owner_id) : _owner_id(owner_id) {
+}
+
+run_loop::~run_loop() {
+    auto *head = this->_head.exchange(nullptr);
+
+    while (head) {
+        auto *const next = head->next;
+        run_loop_utils::destroy(head);
+        head = next;
+    }
+}
+
+void run_loop::execute(execution_f &&execution) {
+    auto *const node = run_loop_utils::make_node(std::move(execution));
+
+    auto *head = this->_head.load();
+    do {
+        node->next = head;
+    } while (!this->_head.compare_exchange_weak(head, node));
+
+    if (this->_is_waiting.load()) {
+        this->_signal.fetch_add(1);
+        this->_signal.notify_one();
+    }
+}
+
+std::size_t run_loop::process() {
+    if (!this->is_current()) {
+        throw std::runtime_error("run_loop process() - called on a thread other than the owner.");
+    }
+
+    // the stack is in reverse order of posting.
+    run_loop_utils::node *reversed = nullptr;
+    auto *head = this->_head.exchange(nullptr);
+    while (head) {
+        auto *const next = head->next;
+        head->next = reversed;
+        reversed = head;
+        head = next;
+    }
+
+    std::size_t count = 0;
+
+    while (reversed) {
+        auto *const node = reversed;
+        reversed = node->next;
+
+        auto const execution = std::move(node->execution);
+        run_loop_utils::destroy(node);
+
+        try {
+            execution();
+        } catch (...) {
+            run_loop_utils::restore(this->_head, reversed);
+            throw;
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+void run_loop::run() {
+    if (!this->is_current()) {
+        throw std::runtime_error("run_loop run() - called on a thread other than the owner.");
+    }
+
+    while (true) {
+        auto const signal = this->_signal.load();
+
+        this->process();
+
+        if (!this->_is_continue.exchange(true)) {
+            break;
+        }
+
+        // a poster sees the waiting flag or the loop sees the posted execution.
+        this->_is_waiting = true;
+
+        if (this->_head.load() == nullptr) {
+            this->_signal.wait(signal);
+        }
+
+        this->_is_waiting = false;
+    }
+}
+
+void run_loop::stop() {
+    this->_is_continue = false;
+    this->_signal.fetch_add(1);
+    this->_signal.notify_one();
+}
+
+bool run_loop::is_current() const {
+    return std::this_thread::get_id() == this->_owner_id;
+}
+
+run_loop_ptr run_loop::make_shared() {
+    return run_loop_ptr(new run_loop{std::this_thread::get_id()});
+}
+
+run_loop_ptr run_loop::main() {
+    auto &holder = run_loop_utils::shared_main_holder();
+
+    std::lock_guard<std::mutex> lock(holder.mutex);
+
+    if (!holder.loop) {
+        holder.loop = run_loop_ptr(new run_loop{run_loop_utils::main_thread_id});
+    }
+
+    return holder.loop;
+}
+
+void run_loop::set_main(run_loop_ptr const &loop) {
+    if (!loop) {
+        throw std::invalid_argument("run_loop set_main() - loop is null.");
+    }
+
+    auto &holder = run_loop_utils::shared_main_holder();
+
+    std::lock_guard<std::mutex> lock(holder.mutex);
+    holder.loop = loop;
+}
@@ -0,0 +1,56 @@
+//
+//  run_loop.h
+//
+
+#pragma once
+
+#include <cpp-utils/executor.h>
+
+#include <atomic>
+#include <thread>
+
+namespace yas::run_loop_utils {
+struct node;
+}
+
+namespace yas {
+class run_loop;
+using run_loop_ptr = std::shared_ptr<run_loop>;
+
+// an executor performing the executions on the thread owning the loop. any thread can post to it without locking. the
+// executions posted until a drain are performed at once in the posted order.
+struct run_loop final : executable {
+    ~run_loop();
+
+    using executable::execute;
+    void execute(execution_f &&) override;
+
+    // performs the posted executions and returns the count. the executions posted while performing are left to the next
+    // call. it throws if it is called on a thread other than the owner. if an execution throws, the exception is rethrown
+    // and the rest of the executions are left to the next call.
+    std::size_t process();
+    // processes the executions on the owner thread until stop() is called. a stop before the run ends the next run.
+    void run();
+    void stop();
+
+    // whether the calling thread is the owner of the loop.
+    [[nodiscard]] bool is_current() const;
+
+    // the loop is owned by the calling thread.
+    static run_loop_ptr make_shared();
+
+    // the loop performing thread::perform_async_on_main outside of apple platforms. it is owned by the main thread by
+    // default and can be replaced with a loop owned by another thread.
+    [[nodiscard]] static run_loop_ptr main();
+    static void set_main(run_loop_ptr const &);
+
+   private:
+    std::thread::id const _owner_id;
+    std::atomic<run_loop_utils::node *> _head = nullptr;
+    std::atomic<uint32_t> _signal = 0;
+    std::atomic<bool> _is_waiting = false;
+    std::atomic<bool> _is_continue = true;
+
+    run_loop(std::thread::id const &owner_id);
+};
+}  // namespace yas
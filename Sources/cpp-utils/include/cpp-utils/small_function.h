@@ -0,0 +1,65 @@
+//
+//  small_function.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace yas {
+template <typename Signature, std::size_t Capacity = 48>
+class small_function;
+
+// a move-only std::function that stores callables up to Capacity bytes without heap allocation.
+template <typename R, typename... Args, std::size_t Capacity>
+class small_function<R(Args...), Capacity> final {
+    static_assert(Capacity >= sizeof(void *), "small_function - capacity is too small.");
+
+   public:
+    small_function() noexcept;
+    small_function(std::nullptr_t) noexcept;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, small_function> &&
+                                                      std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+    small_function(F &&);
+
+    ~small_function();
+
+    small_function(small_function &&) noexcept;
+    small_function &operator=(small_function &&) noexcept;
+    small_function &operator=(std::nullptr_t) noexcept;
+
+    R operator()(Args...) const;
+
+    explicit operator bool() const noexcept;
+
+    [[nodiscard]] bool is_inline() const noexcept;
+
+   private:
+    struct vtable {
+        R (*invoke)(void *, Args &&...);
+        void (*move)(void *dst, void *src) noexcept;
+        void (*destroy)(void *) noexcept;
+        bool is_inline;
+    };
+
+    template <typename F>
+    static constexpr bool is_storable_inline = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+                                               std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static vtable const *_make_vtable();
+
+    alignas(std::max_align_t) mutable std::byte _storage[Capacity];
+    vtable const *_vtable = nullptr;
+
+    void _reset() noexcept;
+
+    small_function(small_function const &) = delete;
+    small_function &operator=(small_function const &) = delete;
+};
+}  // namespace yas
+
+#include "small_function_private.h"
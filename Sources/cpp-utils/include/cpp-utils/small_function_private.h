@@ -0,0 +1,129 @@
+//
+//  small_function_private.h
+//
+
+#pragma once
+
+#include <functional>
+#include <new>
+
+namespace yas {
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity>::small_function() noexcept {
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity>::small_function(std::nullptr_t) noexcept {
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+template <typename F, typename>
+small_function<R(Args...), Capacity>::small_function(F &&function) {
+    using function_t = std::decay_t<F>;
+
+    if constexpr (std::is_pointer_v<function_t> || std::is_member_pointer_v<function_t> ||
+                  std::is_constructible_v<bool, function_t const &>) {
+        if (!function) {
+            return;
+        }
+    }
+
+    if constexpr (is_storable_inline<function_t>) {
+        new (this->_storage) function_t(std::forward<F>(function));
+    } else {
+        new (this->_storage) function_t *(new function_t(std::forward<F>(function)));
+    }
+
+    this->_vtable = _make_vtable<function_t>();
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity>::~small_function() {
+    this->_reset();
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity>::small_function(small_function &&other) noexcept : _vtable(other._vtable) {
+    if (this->_vtable) {
+        this->_vtable->move(this->_storage, other._storage);
+        other._vtable = nullptr;
+    }
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity> &small_function<R(Args...), Capacity>::operator=(
+    small_function &&other) noexcept {
+    if (this != &other) {
+        this->_reset();
+
+        if (other._vtable) {
+            other._vtable->move(this->_storage, other._storage);
+            this->_vtable = other._vtable;
+            other._vtable = nullptr;
+        }
+    }
+
+    return *this;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity> &small_function<R(Args...), Capacity>::operator=(std::nullptr_t) noexcept {
+    this->_reset();
+    return *this;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+R small_function<R(Args...), Capacity>::operator()(Args... args) const {
+    if (!this->_vtable) {
+        throw std::bad_function_call();
+    }
+
+    return this->_vtable->invoke(this->_storage, std::forward<Args>(args)...);
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+small_function<R(Args...), Capacity>::operator bool() const noexcept {
+    return this->_vtable != nullptr;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+bool small_function<R(Args...), Capacity>::is_inline() const noexcept {
+    return this->_vtable && this->_vtable->is_inline;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+template <typename F>
+typename small_function<R(Args...), Capacity>::vtable const *small_function<R(Args...), Capacity>::_make_vtable() {
+    if constexpr (is_storable_inline<F>) {
+        static vtable const table{
+            .invoke = [](void *storage, Args &&...args) -> R {
+                return std::invoke(*static_cast<F *>(storage), std::forward<Args>(args)...);
+            },
+            .move =
+                [](void *dst, void *src) noexcept {
+                    new (dst) F(std::move(*static_cast<F *>(src)));
+                    static_cast<F *>(src)->~F();
+                },
+            .destroy = [](void *storage) noexcept { static_cast<F *>(storage)->~F(); },
+            .is_inline = true};
+        return &table;
+    } else {
+        static vtable const table{
+            .invoke = [](void *storage, Args &&...args) -> R {
+                return std::invoke(**static_cast<F **>(storage), std::forward<Args>(args)...);
+            },
+            .move = [](void *dst, void *src) noexcept { new (dst) F *(*static_cast<F **>(src)); },
+            .destroy = [](void *storage) noexcept { delete *static_cast<F **>(storage); },
+            .is_inline = false};
+        return &table;
+    }
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+void small_function<R(Args...), Capacity>::_reset() noexcept {
+    if (this->_vtable) {
+        this->_vtable->destroy(this->_storage);
+        this->_vtable = nullptr;
+    }
+}
+}  // namespace yas
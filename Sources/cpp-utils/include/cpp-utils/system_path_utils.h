@@ -4,7 +4,9 @@
 
 #pragma once
 
+#if defined(__APPLE__)
 #include <TargetConditionals.h>
+#endif
 
 #include <filesystem>
 #include <string>
@@ -29,7 +31,7 @@ enum class dir {
     pictures,
     shared_public,
     preference_panes,
-#if (TARGET_OS_MAC && !TARGET_OS_IPHONE)
+#if defined(__APPLE__) && (TARGET_OS_MAC && !TARGET_OS_IPHONE)
     application_scripts,
 #endif
     all_applications,
@@ -50,7 +50,7 @@ static NSSearchPathDirectory to_search_path_directory(system_path_utils::dir con
             return NSSharedPublicDirectory;
         case system_path_utils::dir::preference_panes:
             return NSPreferencePanesDirectory;
-#if (TARGET_OS_MAC && !TARGET_OS_IPHONE)
+#if defined(__APPLE__) && (TARGET_OS_MAC && !TARGET_OS_IPHONE)
         case system_path_utils::dir::application_scripts:
             return NSApplicationScriptsDirectory;
 #endif
@@ -0,0 +1,67 @@
+//
+//  system_path_utils_portable.cpp
+//
+
+#if !defined(__APPLE__)
+
+#include "system_path_utils.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace yas;
+
+namespace yas::system_path_utils {
+static std::filesystem::path environment_path(char const *const name) {
+    if (char const *const value = std::getenv(name); value && *value) {
+        return value;
+    }
+    return {};
+}
+
+static std::filesystem::path home_path() {
+    if (auto path = environment_path("HOME"); !path.empty()) {
+        return path;
+    }
+    throw std::runtime_error("system_path_utils directory_path() - HOME is not set.");
+}
+
+// the base directories of the xdg specification, falling back to the defaults under home.
+static std::filesystem::path xdg_path(char const *const name, char const *const default_component) {
+    if (auto path = environment_path(name); !path.empty()) {
+        return path;
+    }
+    return home_path() / default_component;
+}
+}  // namespace yas::system_path_utils
+
+std::filesystem::path system_path_utils::directory_path(dir const dir) {
+    switch (dir) {
+        case dir::temporary:
+            return std::filesystem::temp_directory_path();
+        case dir::home:
+            return home_path();
+        case dir::open_step_root:
+            return "/";
+        case dir::caches:
+            return xdg_path("XDG_CACHE_HOME", ".cache");
+        case dir::application_support:
+            return xdg_path("XDG_DATA_HOME", ".local/share");
+        case dir::desktop:
+            return home_path() / "Desktop";
+        case dir::document:
+            return home_path() / "Documents";
+        case dir::downloads:
+            return home_path() / "Downloads";
+        case dir::movies:
+            return home_path() / "Videos";
+        case dir::music:
+            return home_path() / "Music";
+        case dir::pictures:
+            return home_path() / "Pictures";
+        default:
+            throw std::invalid_argument("invalid directory.");
+    }
+}
+
+#endif
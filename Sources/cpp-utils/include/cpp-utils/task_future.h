@@ -0,0 +1,126 @@
+//
+//  task_future.h
+//
+
+#pragma once
+
+#include <cpp-utils/small_function.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace yas::task_future_utils {
+template <typename T>
+struct state;
+template <typename T>
+struct coroutine_promise;
+template <typename T>
+struct awaiter;
+}
+
+namespace yas {
+template <typename T>
+class task_future;
+template <typename T>
+class task_promise;
+
+enum class task_future_status {
+    pending,
+    completed,
+    failed,
+    // the promise is canceled or destroyed without a result.
+    canceled,
+};
+
+// thrown when the result of a canceled task is requested.
+struct task_canceled_error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// a copyable handle to the result of a task. it is lighter than std::shared_future and can be observed without blocking.
+template <typename T>
+struct task_future final {
+    using value_type = T;
+    using handler_f = small_function<void(task_future const &)>;
+    // a coroutine returning task_future starts at once and completes the future with co_return. it is canceled by an
+    // uncaught task_canceled_error.
+    using promise_type = task_future_utils::coroutine_promise<T>;
+
+    task_future() = default;
+
+    [[nodiscard]] bool is_valid() const;
+    [[nodiscard]] task_future_status status() const;
+    [[nodiscard]] bool is_ready() const;
+
+    void wait() const;
+    [[nodiscard]] bool wait_for(std::chrono::milliseconds const &) const;
+
+    // waits for the result. rethrows the exception of the task if failed, or throws task_canceled_error if canceled.
+    std::conditional_t<std::is_void_v<T>, void, std::add_lvalue_reference_t<T const>> get() const;
+
+    // the handler is called once on the thread completing the future, or immediately if the future is already ready.
+    // if a handler throws, the rest are still called and the first exception is rethrown to the completing side.
+    void on_completed(handler_f &&) const;
+
+    // resumes the awaiting coroutine on the thread completing the future.
+    task_future_utils::awaiter<T> operator co_await() const;
+
+   private:
+    std::shared_ptr<task_future_utils::state<T>> _state = nullptr;
+
+    explicit task_future(std::shared_ptr<task_future_utils::state<T>> const &);
+
+    // adds the handler only if the future is pending. returns false without calling it if the future is ready.
+    [[nodiscard]] bool _add_continuation(handler_f &&) const;
+
+    friend task_promise<T>;
+    friend task_future_utils::awaiter<T>;
+};
+
+// the writing side of task_future. a promise destroyed without a result cancels its future. an exception thrown by a
+// continuation while destroying is dropped.
+template <typename T>
+struct task_promise final {
+    task_promise();
+    ~task_promise();
+
+    task_promise(task_promise &&) noexcept;
+    task_promise &operator=(task_promise &&) noexcept;
+
+    [[nodiscard]] task_future<T> future() const;
+    [[nodiscard]] bool is_satisfied() const;
+
+    template <typename... Args>
+    void set_value(Args &&...);
+    void set_exception(std::exception_ptr const &);
+    void cancel();
+
+   private:
+    std::shared_ptr<task_future_utils::state<T>> _state;
+
+    template <typename Setter>
+    void _complete(task_future_status const, Setter &&, char const *const method);
+
+    task_promise(task_promise const &) = delete;
+    task_promise &operator=(task_promise const &) = delete;
+};
+
+// ready when all of the futures are ready, whether they are completed, failed or canceled.
+template <typename T>
+[[nodiscard]] task_future<void> when_all(std::vector<task_future<T>> const &);
+// ready with the index of the first future to be ready.
+template <typename T>
+[[nodiscard]] task_future<std::size_t> when_any(std::vector<task_future<T>> const &);
+}  // namespace yas
+
+#include "task_future_private.h"
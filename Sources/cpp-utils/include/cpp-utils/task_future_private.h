@@ -0,0 +1,406 @@
+//
+//  task_future_private.h
+//
+
+#pragma once
+
+#include <cpp-utils/pool_allocator.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace yas::task_future_utils {
+template <typename T>
+struct continuation {
+    typename task_future<T>::handler_f handler;
+    continuation *next = nullptr;
+};
+
+template <typename T>
+struct state {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<task_future_status> status = task_future_status::pending;
+    std::optional<std::conditional_t<std::is_void_v<T>, std::monostate, T>> value = std::nullopt;
+    std::exception_ptr exception = nullptr;
+    continuation<T> *head = nullptr;
+    continuation<T> *tail = nullptr;
+
+    ~state() {
+        while (auto *const node = this->head) {
+            this->head = node->next;
+            destroy(node);
+        }
+    }
+
+    // continuations are allocated from the pool so that observing a future does not allocate in a steady state.
+    static continuation<T> *make_continuation(typename task_future<T>::handler_f &&handler) {
+        auto *const node = pool_allocator<continuation<T>>{}.allocate(1);
+        new (node) continuation<T>{std::move(handler)};
+        return node;
+    }
+
+    static void destroy(continuation<T> *const node) {
+        node->~continuation<T>();
+        pool_allocator<continuation<T>>{}.deallocate(node, 1);
+    }
+};
+
+template <typename T>
+struct awaiter {
+    task_future<T> future;
+
+    bool await_ready() const {
+        return this->future.is_ready();
+    }
+
+    // the coroutine is not suspended if the future is completed in the meantime, so that it is not resumed inside here.
+    bool await_suspend(std::coroutine_handle<> const handle) const {
+        return this->future._add_continuation([handle](auto const &) { handle.resume(); });
+    }
+
+    decltype(auto) await_resume() const {
+        return this->future.get();
+    }
+};
+
+template <typename T>
+struct coroutine_promise_base {
+    task_promise<T> promise;
+
+    task_future<T> get_return_object() {
+        return this->promise.future();
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+        return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        try {
+            throw;
+        } catch (task_canceled_error const &) {
+            this->promise.cancel();
+        } catch (...) {
+            this->promise.set_exception(std::current_exception());
+        }
+    }
+};
+
+template <typename T>
+struct coroutine_promise : coroutine_promise_base<T> {
+    template <typename U>
+    void return_value(U &&value) {
+        this->promise.set_value(std::forward<U>(value));
+    }
+};
+
+template <>
+struct coroutine_promise<void> : coroutine_promise_base<void> {
+    void return_void() {
+        this->promise.set_value();
+    }
+};
+}  // namespace yas::task_future_utils
+
+namespace yas {
+#pragma mark - task_future
+
+template <typename T>
+task_future<T>::task_future(std::shared_ptr<task_future_utils::state<T>> const &state) : _state(state) {
+}
+
+template <typename T>
+bool task_future<T>::is_valid() const {
+    return this->_state != nullptr;
+}
+
+template <typename T>
+task_future_status task_future<T>::status() const {
+    if (!this->_state) {
+        throw std::runtime_error("task_future status() - future is invalid.");
+    }
+
+    return this->_state->status;
+}
+
+template <typename T>
+bool task_future<T>::is_ready() const {
+    return this->status() != task_future_status::pending;
+}
+
+template <typename T>
+void task_future<T>::wait() const {
+    if (!this->_state) {
+        throw std::runtime_error("task_future wait() - future is invalid.");
+    }
+
+    auto &state = *this->_state;
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.condition.wait(lock, [&state] { return state.status != task_future_status::pending; });
+}
+
+template <typename T>
+bool task_future<T>::wait_for(std::chrono::milliseconds const &timeout) const {
+    if (!this->_state) {
+        throw std::runtime_error("task_future wait_for() - future is invalid.");
+    }
+
+    auto &state = *this->_state;
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    return state.condition.wait_for(lock, timeout,
+                                    [&state] { return state.status != task_future_status::pending; });
+}
+
+template <typename T>
+std::conditional_t<std::is_void_v<T>, void, std::add_lvalue_reference_t<T const>> task_future<T>::get() const {
+    this->wait();
+
+    auto const &state = *this->_state;
+
+    switch (state.status) {
+        case task_future_status::failed:
+            std::rethrow_exception(state.exception);
+        case task_future_status::canceled:
+            throw task_canceled_error("task_future get() - task is canceled.");
+        default:
+            break;
+    }
+
+    if constexpr (!std::is_void_v<T>) {
+        return state.value.value();
+    }
+}
+
+template <typename T>
+void task_future<T>::on_completed(handler_f &&handler) const {
+    if (!this->_state) {
+        throw std::runtime_error("task_future on_completed() - future is invalid.");
+    }
+
+    if (!this->_add_continuation(std::move(handler))) {
+        handler(*this);
+    }
+}
+
+template <typename T>
+bool task_future<T>::_add_continuation(handler_f &&handler) const {
+    auto &state = *this->_state;
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (state.status != task_future_status::pending) {
+        return false;
+    }
+
+    auto *const node = task_future_utils::state<T>::make_continuation(std::move(handler));
+
+    if (state.tail) {
+        state.tail->next = node;
+    } else {
+        state.head = node;
+    }
+    state.tail = node;
+
+    return true;
+}
+
+template <typename T>
+task_future_utils::awaiter<T> task_future<T>::operator co_await() const {
+    return task_future_utils::awaiter<T>{*this};
+}
+
+#pragma mark - task_promise
+
+template <typename T>
+task_promise<T>::task_promise()
+    : _state(std::allocate_shared<task_future_utils::state<T>>(pool_allocator<task_future_utils::state<T>>{})) {
+}
+
+template <typename T>
+task_promise<T>::~task_promise() {
+    if (this->_state && !this->is_satisfied()) {
+        try {
+            this->cancel();
+        } catch (...) {
+            // the continuations have been called, and an exception cannot leave the destructor.
+        }
+    }
+}
+
+template <typename T>
+task_promise<T>::task_promise(task_promise &&other) noexcept : _state(std::move(other._state)) {
+}
+
+template <typename T>
+task_promise<T> &task_promise<T>::operator=(task_promise &&other) noexcept {
+    if (this != &other) {
+        if (this->_state && !this->is_satisfied()) {
+            try {
+                this->cancel();
+            } catch (...) {
+                // the continuations have been called, and an exception cannot leave the noexcept assignment.
+            }
+        }
+
+        this->_state = std::move(other._state);
+    }
+
+    return *this;
+}
+
+template <typename T>
+task_future<T> task_promise<T>::future() const {
+    if (!this->_state) {
+        throw std::runtime_error("task_promise future() - promise is moved.");
+    }
+
+    return task_future<T>{this->_state};
+}
+
+template <typename T>
+bool task_promise<T>::is_satisfied() const {
+    return this->_state && this->_state->status != task_future_status::pending;
+}
+
+template <typename T>
+template <typename... Args>
+void task_promise<T>::set_value(Args &&...args) {
+    this->_complete(
+        task_future_status::completed, [&args...](auto &state) { state.value.emplace(std::forward<Args>(args)...); },
+        "set_value");
+}
+
+template <typename T>
+void task_promise<T>::set_exception(std::exception_ptr const &exception) {
+    this->_complete(
+        task_future_status::failed, [&exception](auto &state) { state.exception = exception; }, "set_exception");
+}
+
+template <typename T>
+void task_promise<T>::cancel() {
+    this->_complete(
+        task_future_status::canceled, [](auto &) {}, "cancel");
+}
+
+template <typename T>
+template <typename Setter>
+void task_promise<T>::_complete(task_future_status const status, Setter &&setter, char const *const method) {
+    if (!this->_state) {
+        throw std::runtime_error(std::string("task_promise ") + method + "() - promise is moved.");
+    }
+
+    auto &state = *this->_state;
+    task_future_utils::continuation<T> *head = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (state.status != task_future_status::pending) {
+            throw std::runtime_error(std::string("task_promise ") + method + "() - promise is already satisfied.");
+        }
+
+        setter(state);
+        state.status = status;
+
+        head = std::exchange(state.head, nullptr);
+        state.tail = nullptr;
+    }
+
+    state.condition.notify_all();
+
+    task_future<T> const future{this->_state};
+    std::exception_ptr exception = nullptr;
+
+    while (head) {
+        auto *const next = head->next;
+        auto const handler = std::move(head->handler);
+        task_future_utils::state<T>::destroy(head);
+        head = next;
+
+        try {
+            handler(future);
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+#pragma mark - when_all, when_any
+
+template <typename T>
+task_future<void> when_all(std::vector<task_future<T>> const &futures) {
+    task_promise<void> promise;
+    auto future = promise.future();
+
+    if (futures.empty()) {
+        promise.set_value();
+        return future;
+    }
+
+    struct context {
+        std::atomic<std::size_t> remaining;
+        task_promise<void> promise;
+
+        context(std::size_t const count, task_promise<void> &&promise)
+            : remaining(count), promise(std::move(promise)) {
+        }
+    };
+
+    auto const shared_context =
+        std::allocate_shared<context>(pool_allocator<context>{}, futures.size(), std::move(promise));
+
+    for (auto const &each : futures) {
+        each.on_completed([shared_context](auto const &) {
+            if (--shared_context->remaining == 0) {
+                shared_context->promise.set_value();
+            }
+        });
+    }
+
+    return future;
+}
+
+template <typename T>
+task_future<std::size_t> when_any(std::vector<task_future<T>> const &futures) {
+    if (futures.empty()) {
+        throw std::invalid_argument("when_any() - futures is empty.");
+    }
+
+    task_promise<std::size_t> promise;
+    auto future = promise.future();
+
+    struct context {
+        std::atomic<bool> is_ready = false;
+        task_promise<std::size_t> promise;
+
+        context(task_promise<std::size_t> &&promise) : promise(std::move(promise)) {
+        }
+    };
+
+    auto const shared_context = std::allocate_shared<context>(pool_allocator<context>{}, std::move(promise));
+
+    for (std::size_t idx = 0; idx < futures.size(); ++idx) {
+        futures.at(idx).on_completed([shared_context, idx](auto const &) {
+            if (!shared_context->is_ready.exchange(true)) {
+                shared_context->promise.set_value(idx);
+            }
+        });
+    }
+
+    return future;
+}
+}  // namespace yas
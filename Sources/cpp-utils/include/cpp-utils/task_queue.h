@@ -4,25 +4,69 @@
 
 #pragma once
 
-#include <deque>
+#include <cpp-utils/executor.h>
+#include <cpp-utils/metrics.h>
+#include <cpp-utils/pool_allocator.h>
+#include <cpp-utils/ring_deque.h>
+#include <cpp-utils/small_function.h>
+#include <cpp-utils/task_future.h>
+#include <cpp-utils/type_traits.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <functional>
+#include <limits>
 #include <mutex>
 #include <optional>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 #include <atomic>
 
 namespace yas {
 template <typename Canceller>
 class task;
+template <typename Canceller>
+class task_queue;
 
 template <typename Canceller>
-using task_execution_f = std::function<void(task<Canceller> const &)>;
-using task_priority_t = uint32_t;
+using task_execution_f = small_function<void(task<Canceller> const &)>;
 
 template <typename Canceller>
 struct task_option_t {
     task_priority_t priority = 0;
-    std::optional<Canceller> canceller;
+    std::optional<Canceller> canceller = std::nullopt;
+    // a task is canceled instead of being executed if the deadline has passed before it starts.
+    std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+    // the queued tasks with the same canceller are canceled when this task is queued, so that only the latest runs.
+    bool coalescing = false;
+};
+
+enum class task_queue_overflow_policy {
+    // push_back() and push_front() wait until the priority has room. try_push() rejects.
+    block,
+    reject,
+    // the oldest queued task of the priority is canceled to make room.
+    drop_oldest,
+    // the pushed task is canceled instead of being queued.
+    drop_newest,
+};
+
+enum class task_push_result {
+    pushed,
+    // pushed after the oldest queued task is dropped.
+    dropped_oldest,
+    // the pushed task is canceled and not queued.
+    dropped_newest,
+    // the pushed task is not queued and can be pushed again.
+    rejected,
+};
+
+enum class task_queue_ordering {
+    fifo,
+    // tasks with a deadline are executed in order of the deadline, before tasks without one in the same priority.
+    earliest_deadline_first,
 };
 
 template <typename Canceller>
@@ -41,43 +85,222 @@ struct task final {
     task_option_t<Canceller> const _option;
     task_execution_f<Canceller> const _execution;
 
+    // a task waiting in a submission stack of task_queue retains itself until it is drained.
+    std::atomic<bool> _is_submitting = false;
+    std::shared_ptr<task> _submitting = nullptr;
+    task *_next_submitting = nullptr;
+    // the time of the last submission, recorded only while task_queue has metrics.
+    std::atomic<std::chrono::steady_clock::rep> _submitted_time = 0;
+    // whether the task has been executed by task_queue since it was queued last.
+    std::atomic<bool> _is_finished = false;
+
     task(task_execution_f<Canceller> &&, task_option_t<Canceller> &&);
+
+    // returns whether the task is canceled for the first time before it is finished.
+    bool _cancel();
+
+    friend task_queue<Canceller>;
 };
 
 template <typename Canceller>
 struct task_queue final {
     using cancellation_f = std::function<bool(Canceller const &)>;
 
+    // resumes the awaiting coroutine as a task of the queue. throws task_canceled_error on resumption if the task is
+    // canceled. the coroutine uses no thread while it waits.
+    struct schedule_awaiter final {
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> const);
+        void await_resume() const;
+
+       private:
+        std::weak_ptr<task_queue> _weak_queue;
+        task_option_t<Canceller> _option;
+        bool _is_canceled = false;
+
+        schedule_awaiter(std::weak_ptr<task_queue> const &, task_option_t<Canceller> &&);
+
+        friend task_queue;
+    };
+
     ~task_queue();
 
-    void push_back(std::shared_ptr<task<Canceller>> const &);
-    void push_front(std::shared_ptr<task<Canceller>> const &);
+    task_push_result push_back(std::shared_ptr<task<Canceller>> const &);
+    task_push_result push_front(std::shared_ptr<task<Canceller>> const &);
+    // pushes to the back without blocking, even if the overflow policy is block.
+    task_push_result try_push(std::shared_ptr<task<Canceller>> const &);
+    // pushes a task returning a value to the back. the future is canceled if the task is not executed.
+    template <typename F>
+    task_future<std::invoke_result_t<F &, task<Canceller> const &>> submit(F &&, task_option_t<Canceller> &&option = {});
+    [[nodiscard]] schedule_awaiter schedule(task_priority_t const priority);
+    [[nodiscard]] schedule_awaiter schedule(task_option_t<Canceller> &&option = {});
     void cancel(std::shared_ptr<task<Canceller>> const &);
     void cancel(cancellation_f const &);
+    void cancel_by_canceller(Canceller const &);
     void cancel_all();
     void wait_until_all_tasks_are_finished();
+    [[nodiscard]] bool wait_until_all_tasks_are_finished(std::chrono::milliseconds const &timeout);
 
     void suspend();
     void resume();
 
     std::size_t priority_count() const;
+    std::size_t concurrency() const;
     bool is_suspended() const;
     bool is_operating() const;
 
+    void set_ordering(task_queue_ordering const);
+    task_queue_ordering ordering() const;
+
+    // limits the number of queued tasks of the priority. the executing tasks are not counted. nullopt is unlimited.
+    // do not push with the block policy from a task of the same queue, since it may wait for itself.
+    void set_capacity(task_priority_t const, std::optional<std::size_t> const,
+                      task_queue_overflow_policy const = task_queue_overflow_policy::block);
+    std::optional<std::size_t> capacity(task_priority_t const) const;
+    task_queue_overflow_policy overflow_policy(task_priority_t const) const;
+
+    // the number of queued tasks of the same priority passed to the executor as one execution.
+    void set_batch_size(std::size_t const);
+    std::size_t batch_size() const;
+
+    // metrics are not recorded unless they are set. the priority count must be the same as the queue.
+    void set_metrics(task_queue_metrics_ptr const &);
+    task_queue_metrics_ptr metrics() const;
+
     static std::shared_ptr<task_queue> make_shared(std::size_t const priority_count = 1);
+    static std::shared_ptr<task_queue> make_shared(std::size_t const priority_count, executable_ptr const &);
+    static std::shared_ptr<task_queue> make_shared(std::size_t const priority_count, std::size_t const concurrency);
+    static std::shared_ptr<task_queue> make_shared(std::size_t const priority_count, std::size_t const concurrency,
+                                                   executable_ptr const &);
 
    private:
+    struct alignas(64) submission_stack {
+        std::atomic<task<Canceller> *> head = nullptr;
+        // the tasks of the priority submitted or queued. a submission reserves its room before it is published.
+        std::atomic<std::size_t> count = 0;
+        std::atomic<std::size_t> capacity = std::numeric_limits<std::size_t>::max();
+    };
+
+    // the execution of a scheduled task. the coroutine is resumed on the executor as canceled if it is released without
+    // being executed, even if the queue and the executor are released.
+    struct resumer {
+        std::coroutine_handle<> handle;
+        bool *is_canceled;
+        executable_ptr executor;
+        task_priority_t priority;
+
+        resumer(std::coroutine_handle<> const, bool *const is_canceled, executable_ptr const &, task_priority_t const);
+        ~resumer();
+
+        resumer(resumer &&) noexcept;
+
+        void operator()(task<Canceller> const &);
+
+       private:
+        resumer(resumer const &) = delete;
+        resumer &operator=(resumer const &) = delete;
+        resumer &operator=(resumer &&) = delete;
+    };
+
+    struct bound {
+        std::optional<std::size_t> capacity = std::nullopt;
+        task_queue_overflow_policy policy = task_queue_overflow_policy::block;
+    };
+
+    struct deadline_entry {
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence;
+        std::shared_ptr<task<Canceller>> queued;
+
+        // for a min heap ordered by the deadline and then by the sequence.
+        bool operator<(deadline_entry const &rhs) const {
+            return std::tie(this->deadline, this->sequence) > std::tie(rhs.deadline, rhs.sequence);
+        }
+    };
+
     std::weak_ptr<task_queue> _weak_queue;
-    std::shared_ptr<task<Canceller>> _current_task = nullptr;
-    std::vector<std::deque<std::shared_ptr<task<Canceller>>>> _tasks;
+    executable_ptr const _executor;
+    std::size_t const _concurrency;
+    std::vector<std::shared_ptr<task<Canceller>>> _current_tasks;
+    // the tasks of each execution by lane. a lane is reused after its execution is finished.
+    std::vector<std::vector<std::shared_ptr<task<Canceller>>>> _batches;
+    std::vector<std::size_t> _free_lanes;
+    std::size_t _batch_size = 1;
+    std::vector<ring_deque<std::shared_ptr<task<Canceller>>>> _tasks;
+    // the tasks with a deadline in earliest_deadline_first ordering.
+    std::vector<std::vector<deadline_entry>> _deadline_tasks;
+    uint64_t _deadline_sequence = 0;
+    task_queue_ordering _ordering = task_queue_ordering::fifo;
+    std::vector<submission_stack> _submissions;
+    std::vector<bound> _bounds;
+    std::size_t _blocked_count = 0;
+    std::condition_variable_any _capacity_condition;
+    std::atomic<bool> _is_draining_requested = false;
+
+    // the tasks queued or executing, to find a task by its handle or its canceller without scanning the deques.
+    using task_counts_t =
+        std::unordered_map<task<Canceller> const *, std::size_t, std::hash<task<Canceller> const *>,
+                           std::equal_to<task<Canceller> const *>,
+                           pool_allocator<std::pair<task<Canceller> const *const, std::size_t>>>;
+    using canceller_tasks_t =
+        std::conditional_t<is_hashable_v<Canceller>,
+                           std::unordered_multimap<Canceller, task<Canceller> *, std::hash<Canceller>,
+                                                   std::equal_to<Canceller>,
+                                                   pool_allocator<std::pair<Canceller const, task<Canceller> *>>>,
+                           std::nullptr_t>;
+    // the nodes unindexed from the maps are kept for reuse, so that indexing on any thread does not allocate in a
+    // steady state. the nodes of cancellers which are not trivially destructible are not kept, not to retain them.
+    template <typename Index>
+    struct index_nodes {
+        std::vector<typename Index::node_type> nodes;
+    };
+    static constexpr bool _is_canceller_node_reusable =
+        is_hashable_v<Canceller> && std::is_trivially_destructible_v<Canceller>;
+
+    task_counts_t _task_counts;
+    canceller_tasks_t _canceller_tasks;
+    index_nodes<task_counts_t> _free_task_count_nodes;
+    std::conditional_t<_is_canceller_node_reusable, index_nodes<canceller_tasks_t>, std::nullptr_t>
+        _free_canceller_task_nodes;
     bool _suspended = false;
+    task_queue_metrics_ptr _metrics = nullptr;
+    std::atomic<bool> _is_metrics_enabled = false;
     mutable std::recursive_mutex _mutex;
+    std::condition_variable_any _finished_condition;
 
-    task_queue(std::size_t const priority_count);
+    task_queue(std::size_t const priority_count, std::size_t const concurrency, executable_ptr const &);
 
+    void _drain_submissions();
+    void _drain_submissions_if_possible();
+    bool _has_submissions() const;
+    void _enqueue_back(std::shared_ptr<task<Canceller>> &&);
+    void _enqueue_front(std::shared_ptr<task<Canceller>> &&);
+    std::size_t _queued_count() const;
+    task_push_result _push_back(std::shared_ptr<task<Canceller>> const &, bool const is_blocking);
+    task_push_result _push_bounded(std::shared_ptr<task<Canceller>> const &, bool const is_front,
+                                   bool const is_blocking);
+    void _push_locked(std::shared_ptr<task<Canceller>> const &, bool const is_front);
+    bool _is_full(task_priority_t const) const;
+    bool _reserve(task_priority_t const);
+    void _release(task_priority_t const, std::size_t const);
+    bool _drop_oldest(task_priority_t const);
+    void _add_overflow_count(std::size_t const);
+    void _notify_capacity_if_needed();
+    void _coalesce_if_needed(std::shared_ptr<task<Canceller>> const &);
+    void _index_task(std::shared_ptr<task<Canceller>> const &);
+    void _add_queue_depth(std::size_t const);
+    void _subtract_queue_depth(std::size_t const);
+    void _add_cancellation_count(std::size_t const);
+    void _unindex_task(std::shared_ptr<task<Canceller>> const &);
     std::shared_ptr<task<Canceller>> _pop_task();
+    std::shared_ptr<task<Canceller>> _pop_task_at(std::size_t const priority);
+    bool _drop_if_needed(std::shared_ptr<task<Canceller>> const &, std::chrono::steady_clock::time_point const &);
     void _begin_next_task_if_needed();
-    void _task_did_finish_on_bg(std::shared_ptr<task<Canceller>> const &pre_task);
+    void _execute_batch_on_bg(std::size_t const lane, task_queue_metrics_ptr const &);
+    void _batch_did_finish_on_bg(std::size_t const lane);
+    static void _execute_with_metrics(task<Canceller> &, task_queue_metrics &);
+    bool _is_waiting_finished() const;
+    void _notify_if_finished();
 };
 }  // namespace yas
 
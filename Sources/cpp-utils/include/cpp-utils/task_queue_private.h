@@ -4,16 +4,18 @@
 
 #pragma once
 
+#include <cpp-utils/pool_allocator.h>
 #include <cpp-utils/stl_utils.h>
 
-#include <thread>
+#include <algorithm>
+#include <stdexcept>
 
 #pragma mark - task
 
 namespace yas {
 template <typename Canceller>
 task<Canceller>::task(task_execution_f<Canceller> &&execution, task_option_t<Canceller> &&option)
-    : _canceled(false), _execution(std::move(execution)), _option(std::move(option)) {
+    : _canceled(false), _option(std::move(option)), _execution(std::move(execution)) {
 }
 
 template <typename Canceller>
@@ -21,6 +23,11 @@ void task<Canceller>::cancel() {
     this->_canceled = true;
 }
 
+template <typename Canceller>
+bool task<Canceller>::_cancel() {
+    return !this->_canceled.exchange(true) && !this->_is_finished;
+}
+
 template <typename Canceller>
 bool task<Canceller>::is_canceled() const {
     return this->_canceled;
@@ -43,13 +50,127 @@ void task<Canceller>::execute() {
 template <typename Canceller>
 std::shared_ptr<task<Canceller>> task<Canceller>::make_shared(task_execution_f<Canceller> &&execution,
                                                               task_option_t<Canceller> &&option) {
-    return std::shared_ptr<task>(new task{std::move(execution), std::move(option)});
+    // the task and the control block are allocated from pools to keep submitting free from heap allocations.
+    pool_allocator<task> allocator;
+    auto *const ptr = allocator.allocate(1);
+
+    try {
+        new (ptr) task{std::move(execution), std::move(option)};
+    } catch (...) {
+        allocator.deallocate(ptr, 1);
+        throw;
+    }
+
+    return std::shared_ptr<task>(
+        ptr,
+        [](task *ptr) {
+            ptr->~task();
+            pool_allocator<task>{}.deallocate(ptr, 1);
+        },
+        allocator);
+}
+
+#pragma mark - task_queue::schedule_awaiter
+
+template <typename Canceller>
+task_queue<Canceller>::schedule_awaiter::schedule_awaiter(std::weak_ptr<task_queue> const &weak_queue,
+                                                          task_option_t<Canceller> &&option)
+    : _weak_queue(weak_queue), _option(std::move(option)) {
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::schedule_awaiter::await_ready() const noexcept {
+    return false;
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::schedule_awaiter::await_suspend(std::coroutine_handle<> const handle) {
+    auto const queue = this->_weak_queue.lock();
+
+    if (!queue) {
+        this->_is_canceled = true;
+        return false;
+    }
+
+    auto const priority = this->_option.priority;
+    auto scheduled = task<Canceller>::make_shared(resumer{handle, &this->_is_canceled, queue->_executor, priority},
+                                                  task_option_t<Canceller>{this->_option});
+
+    // the coroutine may be resumed on another thread before push_back() returns, so this awaiter is not touched after.
+    queue->push_back(scheduled);
+
+    return true;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::schedule_awaiter::await_resume() const {
+    if (this->_is_canceled) {
+        throw task_canceled_error("task_queue schedule() - task is canceled.");
+    }
+}
+
+#pragma mark - task_queue::resumer
+
+template <typename Canceller>
+task_queue<Canceller>::resumer::resumer(std::coroutine_handle<> const handle, bool *const is_canceled,
+                                        executable_ptr const &executor, task_priority_t const priority)
+    : handle(handle), is_canceled(is_canceled), executor(executor), priority(priority) {
+}
+
+template <typename Canceller>
+task_queue<Canceller>::resumer::resumer(resumer &&other) noexcept
+    : handle(std::exchange(other.handle, nullptr)),
+      is_canceled(other.is_canceled),
+      executor(std::move(other.executor)),
+      priority(other.priority) {
+}
+
+template <typename Canceller>
+task_queue<Canceller>::resumer::~resumer() {
+    if (this->handle) {
+        // released under the lock of the queue in most cases, so the coroutine is not resumed here. the execution
+        // retains the executor, since the queue owning it may be being destroyed and the executor drops the pending
+        // executions when it is destroyed.
+        *this->is_canceled = true;
+        this->executor->execute(this->priority,
+                                [handle = this->handle, executor = this->executor] { handle.resume(); });
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::resumer::operator()(task<Canceller> const &) {
+    if (auto const handle = std::exchange(this->handle, nullptr)) {
+        handle.resume();
+    }
 }
 
 #pragma mark - task_queue
 
 template <typename Canceller>
-task_queue<Canceller>::task_queue(std::size_t const priority_count) : _tasks(priority_count) {
+task_queue<Canceller>::task_queue(std::size_t const priority_count, std::size_t const concurrency,
+                                  executable_ptr const &executor)
+    : _executor(executor),
+      _concurrency(concurrency),
+      _tasks(priority_count),
+      _deadline_tasks(priority_count),
+      _submissions(priority_count),
+      _bounds(priority_count) {
+    if (!executor) {
+        throw std::invalid_argument("task_queue - executor is null.");
+    }
+
+    if (concurrency == 0) {
+        throw std::invalid_argument("task_queue - concurrency is zero.");
+    }
+
+    this->_current_tasks.reserve(concurrency);
+    this->_batches.resize(concurrency);
+    this->_free_lanes.reserve(concurrency);
+
+    for (std::size_t idx = 0; idx < concurrency; ++idx) {
+        this->_batches.at(idx).reserve(this->_batch_size);
+        this->_free_lanes.emplace_back(concurrency - idx - 1);
+    }
 }
 
 template <typename Canceller>
@@ -58,98 +179,237 @@ task_queue<Canceller>::~task_queue() {
 }
 
 template <typename Canceller>
-void task_queue<Canceller>::push_back(std::shared_ptr<task<Canceller>> const &task) {
-    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+task_push_result task_queue<Canceller>::push_back(std::shared_ptr<task<Canceller>> const &task) {
+    return this->_push_back(task, true);
+}
 
-    this->_tasks.at(task->option().priority).emplace_back(task);
-    this->_begin_next_task_if_needed();
+template <typename Canceller>
+task_push_result task_queue<Canceller>::push_front(std::shared_ptr<task<Canceller>> const &task) {
+    return this->_push_bounded(task, true, true);
 }
 
 template <typename Canceller>
-void task_queue<Canceller>::push_front(std::shared_ptr<task<Canceller>> const &task) {
-    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+task_push_result task_queue<Canceller>::try_push(std::shared_ptr<task<Canceller>> const &task) {
+    return this->_push_back(task, false);
+}
 
-    this->_tasks.at(task->option().priority).emplace_front(task);
-    this->_begin_next_task_if_needed();
+template <typename Canceller>
+template <typename F>
+task_future<std::invoke_result_t<F &, task<Canceller> const &>> task_queue<Canceller>::submit(
+    F &&function, task_option_t<Canceller> &&option) {
+    using result_t = std::invoke_result_t<F &, task<Canceller> const &>;
+
+    // the promise is held by the execution, so the future is canceled when the task is released without execution.
+    task_promise<result_t> promise;
+    auto future = promise.future();
+
+    this->push_back(task<Canceller>::make_shared(
+        [promise = std::move(promise), function = std::forward<F>(function)](task<Canceller> const &task) mutable {
+            if (promise.is_satisfied()) {
+                return;
+            }
+
+            try {
+                if constexpr (std::is_void_v<result_t>) {
+                    function(task);
+                    promise.set_value();
+                } else {
+                    promise.set_value(function(task));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        },
+        std::move(option)));
+
+    return future;
+}
+
+template <typename Canceller>
+typename task_queue<Canceller>::schedule_awaiter task_queue<Canceller>::schedule(task_priority_t const priority) {
+    return this->schedule({.priority = priority});
+}
+
+template <typename Canceller>
+typename task_queue<Canceller>::schedule_awaiter task_queue<Canceller>::schedule(task_option_t<Canceller> &&option) {
+    if (option.priority >= this->_tasks.size()) {
+        throw std::out_of_range("task_queue schedule() - priority is out of range.");
+    }
+
+    return schedule_awaiter{this->_weak_queue, std::move(option)};
 }
 
 template <typename Canceller>
 void task_queue<Canceller>::cancel(std::shared_ptr<task<Canceller>> const &canceling_task) {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    for (auto &deque : this->_tasks) {
-        for (auto &task : deque) {
-            if (canceling_task == task) {
-                task->cancel();
+    this->_drain_submissions();
+
+    // a canceled task stays in the deque and is skipped when it is popped.
+    if (this->_task_counts.contains(canceling_task.get()) && canceling_task->_cancel()) {
+        this->_add_cancellation_count(1);
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::cancel(cancellation_f const &cancellation) {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    this->_drain_submissions();
+
+    std::size_t erased_count = 0;
+    std::size_t canceled_count = 0;
+
+    auto const is_canceling = [this, &cancellation, &canceled_count](auto const &task) {
+        auto const &canceller = task->option().canceller;
+        if (canceller.has_value() && cancellation(canceller.value())) {
+            if (task->_cancel()) {
+                ++canceled_count;
             }
+            this->_unindex_task(task);
+            return true;
         }
+        return false;
+    };
+
+    for (std::size_t idx = 0; idx < this->_tasks.size(); ++idx) {
+        auto count = this->_tasks.at(idx).erase_if(is_canceling);
+
+        auto &heap = this->_deadline_tasks.at(idx);
+        count += std::erase_if(heap, [&is_canceling](auto const &entry) { return is_canceling(entry.queued); });
+        std::make_heap(heap.begin(), heap.end());
+
+        this->_release(idx, count);
+        erased_count += count;
     }
 
-    if (this->_current_task) {
-        if (this->_current_task == canceling_task) {
-            this->_current_task->cancel();
+    for (auto const &task : this->_current_tasks) {
+        auto const &canceller = task->option().canceller;
+        if (canceller.has_value() && cancellation(canceller.value()) && task->_cancel()) {
+            ++canceled_count;
         }
     }
+
+    this->_subtract_queue_depth(erased_count);
+    this->_add_cancellation_count(canceled_count);
+
+    this->_notify_capacity_if_needed();
+    this->_notify_if_finished();
 }
 
 template <typename Canceller>
-void task_queue<Canceller>::cancel(cancellation_f const &cancellation) {
+void task_queue<Canceller>::cancel_by_canceller(Canceller const &canceller) {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    for (auto &deque : this->_tasks) {
-        std::erase_if(deque, [&cancellation](auto const &task) {
-            auto const &canceller = task->option().canceller;
-            return canceller.has_value() && cancellation(canceller.value());
-        });
-    }
+    this->_drain_submissions();
 
-    if (this->_current_task) {
-        auto const &canceller = this->_current_task->option().canceller;
-        if (canceller.has_value() && cancellation(canceller.value())) {
-            this->_current_task->cancel();
+    std::size_t canceled_count = 0;
+
+    if constexpr (is_hashable_v<Canceller>) {
+        auto const range = this->_canceller_tasks.equal_range(canceller);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->_cancel()) {
+                ++canceled_count;
+            }
+        }
+    } else {
+        for (auto const &deque : this->_tasks) {
+            for (auto const &task : deque) {
+                if (task->option().canceller == canceller && task->_cancel()) {
+                    ++canceled_count;
+                }
+            }
+        }
+
+        for (auto const &heap : this->_deadline_tasks) {
+            for (auto const &entry : heap) {
+                if (entry.queued->option().canceller == canceller && entry.queued->_cancel()) {
+                    ++canceled_count;
+                }
+            }
+        }
+
+        for (auto const &task : this->_current_tasks) {
+            if (task->option().canceller == canceller && task->_cancel()) {
+                ++canceled_count;
+            }
         }
     }
+
+    this->_add_cancellation_count(canceled_count);
 }
 
 template <typename Canceller>
 void task_queue<Canceller>::cancel_all() {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    for (auto &deque : this->_tasks) {
+    this->_drain_submissions();
+
+    std::size_t cleared_count = 0;
+    std::size_t canceled_count = 0;
+
+    for (std::size_t idx = 0; idx < this->_tasks.size(); ++idx) {
+        auto &deque = this->_tasks.at(idx);
         for (auto &task : deque) {
-            task->cancel();
+            if (task->_cancel()) {
+                ++canceled_count;
+            }
+            this->_unindex_task(task);
+        }
+
+        auto &heap = this->_deadline_tasks.at(idx);
+        for (auto &entry : heap) {
+            if (entry.queued->_cancel()) {
+                ++canceled_count;
+            }
+            this->_unindex_task(entry.queued);
         }
+
+        auto const count = deque.size() + heap.size();
         deque.clear();
+        heap.clear();
+
+        this->_release(idx, count);
+        cleared_count += count;
     }
 
-    if (this->_current_task) {
-        this->_current_task->cancel();
+    for (auto const &task : this->_current_tasks) {
+        if (task->_cancel()) {
+            ++canceled_count;
+        }
     }
+
+    this->_subtract_queue_depth(cleared_count);
+    this->_add_cancellation_count(canceled_count);
+
+    this->_notify_capacity_if_needed();
+    this->_notify_if_finished();
 }
 
 template <typename Canceller>
 void task_queue<Canceller>::wait_until_all_tasks_are_finished() {
-    while (true) {
-        std::lock_guard<std::recursive_mutex> lock(this->_mutex);
-
-        bool task_exists = this->_current_task != nullptr;
-        if (!task_exists) {
-            for (auto &deque : this->_tasks) {
-                if (deque.size() > 0) {
-                    task_exists = true;
-                }
-            }
-        }
+    std::unique_lock<std::recursive_mutex> lock(this->_mutex);
 
-        if (task_exists) {
-            if (this->_suspended) {
-                throw std::runtime_error("task_queue is suspended.");
-            }
-            std::this_thread::yield();
-        } else {
-            break;
-        }
+    this->_finished_condition.wait(lock, [this] { return this->_is_waiting_finished(); });
+
+    if (this->is_operating()) {
+        throw std::runtime_error("task_queue is suspended.");
+    }
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::wait_until_all_tasks_are_finished(std::chrono::milliseconds const &timeout) {
+    std::unique_lock<std::recursive_mutex> lock(this->_mutex);
+
+    if (!this->_finished_condition.wait_for(lock, timeout, [this] { return this->_is_waiting_finished(); })) {
+        return false;
+    }
+
+    if (this->is_operating()) {
+        throw std::runtime_error("task_queue is suspended.");
     }
+
+    return true;
 }
 
 template <typename Canceller>
@@ -157,6 +417,8 @@ void task_queue<Canceller>::suspend() {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
     this->_suspended = true;
+
+    this->_finished_condition.notify_all();
 }
 
 template <typename Canceller>
@@ -174,6 +436,11 @@ std::size_t task_queue<Canceller>::priority_count() const {
     return this->_tasks.size();
 }
 
+template <typename Canceller>
+std::size_t task_queue<Canceller>::concurrency() const {
+    return this->_concurrency;
+}
+
 template <typename Canceller>
 bool task_queue<Canceller>::is_suspended() const {
     return this->_suspended;
@@ -183,70 +450,738 @@ template <typename Canceller>
 bool task_queue<Canceller>::is_operating() const {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    if (this->_current_task) {
-        return true;
+    return !this->_current_tasks.empty() || this->_has_submissions() || this->_queued_count() > 0;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::set_ordering(task_queue_ordering const ordering) {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    if (this->_ordering == ordering) {
+        return;
+    }
+
+    this->_drain_submissions();
+
+    this->_ordering = ordering;
+
+    if (ordering == task_queue_ordering::earliest_deadline_first) {
+        // rotates the deques to move the deadline tasks to the heaps.
+        for (auto &deque : this->_tasks) {
+            std::size_t const count = deque.size();
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                auto task = std::move(deque.front());
+                deque.pop_front();
+                this->_enqueue_back(std::move(task));
+            }
+        }
+    } else {
+        // the deadline tasks are put back to the front of the deques in order of the deadline.
+        for (std::size_t idx = 0; idx < this->_deadline_tasks.size(); ++idx) {
+            auto &heap = this->_deadline_tasks.at(idx);
+            std::sort_heap(heap.begin(), heap.end());
+            for (auto &entry : heap) {
+                this->_tasks.at(idx).emplace_front(std::move(entry.queued));
+            }
+            heap.clear();
+        }
+    }
+}
+
+template <typename Canceller>
+task_queue_ordering task_queue<Canceller>::ordering() const {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+    return this->_ordering;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::set_capacity(task_priority_t const priority, std::optional<std::size_t> const capacity,
+                                         task_queue_overflow_policy const policy) {
+    if (capacity == std::size_t(0)) {
+        throw std::invalid_argument("task_queue set_capacity() - capacity is zero.");
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    this->_bounds.at(priority) = bound{.capacity = capacity, .policy = policy};
+    this->_submissions.at(priority).capacity = capacity.value_or(std::numeric_limits<std::size_t>::max());
+
+    this->_notify_capacity_if_needed();
+}
+
+template <typename Canceller>
+std::optional<std::size_t> task_queue<Canceller>::capacity(task_priority_t const priority) const {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+    return this->_bounds.at(priority).capacity;
+}
+
+template <typename Canceller>
+task_queue_overflow_policy task_queue<Canceller>::overflow_policy(task_priority_t const priority) const {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+    return this->_bounds.at(priority).policy;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::set_batch_size(std::size_t const batch_size) {
+    if (batch_size == 0) {
+        throw std::invalid_argument("task_queue set_batch_size() - batch_size is zero.");
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    this->_batch_size = batch_size;
+
+    for (auto const &lane : this->_free_lanes) {
+        this->_batches.at(lane).reserve(batch_size);
+    }
+}
+
+template <typename Canceller>
+std::size_t task_queue<Canceller>::batch_size() const {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+    return this->_batch_size;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::set_metrics(task_queue_metrics_ptr const &metrics) {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    if (metrics && metrics->priority_count() != this->priority_count()) {
+        throw std::invalid_argument("task_queue set_metrics() - priority_count is mismatched.");
+    }
+
+    if (metrics == this->_metrics) {
+        return;
+    }
+
+    this->_drain_submissions();
+
+    this->_metrics = metrics;
+    this->_is_metrics_enabled = metrics != nullptr;
+
+    if (metrics) {
+        metrics->add_queue_depth(this->_queued_count());
+    }
+}
+
+template <typename Canceller>
+task_queue_metrics_ptr task_queue<Canceller>::metrics() const {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+    return this->_metrics;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_drain_submissions() {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    std::size_t idx = 0;
+    std::size_t drained_count = 0;
+
+    for (auto &submission : this->_submissions) {
+        // the stack is in reverse order of submission.
+        task<Canceller> *reversed = nullptr;
+        auto *head = submission.head.exchange(nullptr);
+        while (head) {
+            auto *next = head->_next_submitting;
+            head->_next_submitting = reversed;
+            reversed = head;
+            head = next;
+        }
+
+        while (reversed) {
+            auto *next = reversed->_next_submitting;
+            reversed->_next_submitting = nullptr;
+            auto task = std::move(reversed->_submitting);
+            task->_is_submitting = false;
+            this->_index_task(task);
+            this->_enqueue_back(std::move(task));
+            reversed = next;
+            ++drained_count;
+        }
+
+        ++idx;
+    }
+
+    this->_add_queue_depth(drained_count);
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_drain_submissions_if_possible() {
+    std::unique_lock<std::recursive_mutex> lock(this->_mutex, std::try_to_lock);
+
+    if (lock.owns_lock()) {
+        this->_begin_next_task_if_needed();
+    } else if (!this->_is_draining_requested.exchange(true)) {
+        // the holder of the mutex may have already drained, so drain again after it.
+        this->_executor->execute([weak_queue = this->_weak_queue] {
+            if (auto const queue = weak_queue.lock()) {
+                std::lock_guard<std::recursive_mutex> lock(queue->_mutex);
+
+                queue->_is_draining_requested = false;
+                queue->_begin_next_task_if_needed();
+            }
+        });
+    }
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_has_submissions() const {
+    for (auto const &submission : this->_submissions) {
+        if (submission.head.load() != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_enqueue_back(std::shared_ptr<task<Canceller>> &&task) {
+    auto const priority = task->option().priority;
+
+    if (this->_ordering == task_queue_ordering::earliest_deadline_first) {
+        if (auto const &deadline = task->option().deadline) {
+            auto &heap = this->_deadline_tasks.at(priority);
+            heap.emplace_back(deadline_entry{
+                .deadline = deadline.value(), .sequence = this->_deadline_sequence++, .queued = std::move(task)});
+            std::push_heap(heap.begin(), heap.end());
+            return;
+        }
+    }
+
+    this->_tasks.at(priority).emplace_back(std::move(task));
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_enqueue_front(std::shared_ptr<task<Canceller>> &&task) {
+    auto const priority = task->option().priority;
+
+    if (this->_ordering == task_queue_ordering::earliest_deadline_first && task->option().deadline.has_value()) {
+        this->_enqueue_back(std::move(task));
+    } else {
+        this->_tasks.at(priority).emplace_front(std::move(task));
     }
+}
+
+template <typename Canceller>
+std::size_t task_queue<Canceller>::_queued_count() const {
+    std::size_t count = 0;
 
     for (auto const &deque : this->_tasks) {
-        if (deque.size() > 0) {
+        count += deque.size();
+    }
+
+    for (auto const &heap : this->_deadline_tasks) {
+        count += heap.size();
+    }
+
+    return count;
+}
+
+template <typename Canceller>
+task_push_result task_queue<Canceller>::_push_back(std::shared_ptr<task<Canceller>> const &task,
+                                                   bool const is_blocking) {
+    auto const priority = task->option().priority;
+
+    if (task->option().coalescing) {
+        // the replaced tasks are removed under the lock before the room is reserved.
+        return this->_push_bounded(task, false, is_blocking);
+    }
+
+    if (task->_is_submitting.exchange(true)) {
+        // the same task is already waiting in a submission stack.
+        return this->_push_bounded(task, false, is_blocking);
+    }
+
+    if (!this->_reserve(priority)) {
+        task->_is_submitting = false;
+        return this->_push_bounded(task, false, is_blocking);
+    }
+
+    if (this->_is_metrics_enabled.load(std::memory_order_relaxed)) {
+        task->_submitted_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    auto &submission = this->_submissions.at(priority);
+
+    task->_submitting = task;
+    auto *head = submission.head.load();
+    do {
+        task->_next_submitting = head;
+    } while (!submission.head.compare_exchange_weak(head, task.get()));
+
+    this->_drain_submissions_if_possible();
+
+    return task_push_result::pushed;
+}
+
+template <typename Canceller>
+task_push_result task_queue<Canceller>::_push_bounded(std::shared_ptr<task<Canceller>> const &task,
+                                                      bool const is_front, bool const is_blocking) {
+    std::unique_lock<std::recursive_mutex> lock(this->_mutex);
+
+    if (this->_metrics) {
+        task->_submitted_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    this->_drain_submissions();
+    this->_coalesce_if_needed(task);
+
+    auto const priority = task->option().priority;
+    auto result = task_push_result::pushed;
+
+    while (!this->_reserve(priority)) {
+        switch (this->_bounds.at(priority).policy) {
+            case task_queue_overflow_policy::block:
+                if (!is_blocking) {
+                    this->_add_overflow_count(1);
+                    return task_push_result::rejected;
+                }
+
+                ++this->_blocked_count;
+                this->_capacity_condition.wait(lock, [this, priority] { return !this->_is_full(priority); });
+                --this->_blocked_count;
+                break;
+            case task_queue_overflow_policy::reject:
+                this->_add_overflow_count(1);
+                return task_push_result::rejected;
+            case task_queue_overflow_policy::drop_oldest:
+                this->_drain_submissions();
+                if (!this->_drop_oldest(priority)) {
+                    // the room is reserved by a submission not published yet. it is dropped after it is drained.
+                    ++this->_blocked_count;
+                    this->_capacity_condition.wait(
+                        lock, [this, priority] { return this->_has_submissions() || !this->_is_full(priority); });
+                    --this->_blocked_count;
+                }
+                result = task_push_result::dropped_oldest;
+                break;
+            case task_queue_overflow_policy::drop_newest:
+                task->cancel();
+                this->_add_overflow_count(1);
+                return task_push_result::dropped_newest;
+        }
+    }
+
+    this->_push_locked(task, is_front);
+
+    return result;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_push_locked(std::shared_ptr<task<Canceller>> const &task, bool const is_front) {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    this->_drain_submissions();
+    this->_index_task(task);
+
+    if (is_front) {
+        this->_enqueue_front(std::shared_ptr<yas::task<Canceller>>{task});
+    } else {
+        this->_enqueue_back(std::shared_ptr<yas::task<Canceller>>{task});
+    }
+
+    this->_add_queue_depth(1);
+    this->_begin_next_task_if_needed();
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_is_full(task_priority_t const priority) const {
+    auto const &submission = this->_submissions.at(priority);
+    return submission.count.load() >= submission.capacity.load();
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_reserve(task_priority_t const priority) {
+    auto &submission = this->_submissions.at(priority);
+
+    auto count = submission.count.load();
+    do {
+        if (count >= submission.capacity.load()) {
+            return false;
+        }
+    } while (!submission.count.compare_exchange_weak(count, count + 1));
+
+    return true;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_release(task_priority_t const priority, std::size_t const count) {
+    if (count > 0) {
+        this->_submissions.at(priority).count.fetch_sub(count);
+    }
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_drop_oldest(task_priority_t const priority) {
+    std::shared_ptr<task<Canceller>> dropped = nullptr;
+
+    if (auto &deque = this->_tasks.at(priority); !deque.empty()) {
+        dropped = std::move(deque.front());
+        deque.pop_front();
+    } else if (auto &heap = this->_deadline_tasks.at(priority); !heap.empty()) {
+        auto const it = std::min_element(heap.begin(), heap.end(), [](auto const &lhs, auto const &rhs) {
+            return lhs.sequence < rhs.sequence;
+        });
+        dropped = std::move(it->queued);
+        heap.erase(it);
+        std::make_heap(heap.begin(), heap.end());
+    } else {
+        return false;
+    }
+
+    dropped->cancel();
+    this->_unindex_task(dropped);
+    this->_release(priority, 1);
+    this->_subtract_queue_depth(1);
+    this->_add_overflow_count(1);
+
+    return true;
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_add_overflow_count(std::size_t const count) {
+    if (this->_metrics && count > 0) {
+        this->_metrics->add_overflow_count(count);
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_notify_capacity_if_needed() {
+    if (this->_blocked_count > 0) {
+        this->_capacity_condition.notify_all();
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_coalesce_if_needed(std::shared_ptr<task<Canceller>> const &task) {
+    auto const &canceller = task->option().canceller;
+
+    if (!task->option().coalescing || !canceller.has_value()) {
+        return;
+    }
+
+    if constexpr (is_hashable_v<Canceller>) {
+        auto const range = this->_canceller_tasks.equal_range(canceller.value());
+        if (std::none_of(range.first, range.second, [&task](auto const &pair) { return pair.second != task.get(); })) {
+            return;
+        }
+    }
+
+    // the replaced tasks are removed to release their rooms. the executing tasks are not in the queue.
+    auto const is_replaced = [this, &task, &canceller](auto const &other) {
+        if (other != task && other->option().canceller == canceller) {
+            other->cancel();
+            this->_unindex_task(other);
             return true;
         }
+        return false;
+    };
+
+    std::size_t erased_count = 0;
+
+    for (std::size_t idx = 0; idx < this->_tasks.size(); ++idx) {
+        auto count = this->_tasks.at(idx).erase_if(is_replaced);
+
+        auto &heap = this->_deadline_tasks.at(idx);
+        count += std::erase_if(heap, [&is_replaced](auto const &entry) { return is_replaced(entry.queued); });
+        std::make_heap(heap.begin(), heap.end());
+
+        this->_release(idx, count);
+        erased_count += count;
     }
 
-    return false;
+    this->_subtract_queue_depth(erased_count);
+    this->_notify_capacity_if_needed();
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_index_task(std::shared_ptr<task<Canceller>> const &task) {
+    task->_is_finished = false;
+
+    if (auto const it = this->_task_counts.find(task.get()); it != this->_task_counts.end()) {
+        ++it->second;
+    } else if (auto &nodes = this->_free_task_count_nodes.nodes; !nodes.empty()) {
+        auto node = std::move(nodes.back());
+        nodes.pop_back();
+        node.key() = task.get();
+        node.mapped() = 1;
+        this->_task_counts.insert(std::move(node));
+    } else {
+        this->_task_counts.emplace(task.get(), 1);
+    }
+
+    if constexpr (is_hashable_v<Canceller>) {
+        if (auto const &canceller = task->option().canceller) {
+            if constexpr (_is_canceller_node_reusable) {
+                if (auto &nodes = this->_free_canceller_task_nodes.nodes; !nodes.empty()) {
+                    auto node = std::move(nodes.back());
+                    nodes.pop_back();
+                    node.key() = canceller.value();
+                    node.mapped() = task.get();
+                    this->_canceller_tasks.insert(std::move(node));
+                    return;
+                }
+            }
+
+            this->_canceller_tasks.emplace(canceller.value(), task.get());
+        }
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_add_queue_depth(std::size_t const count) {
+    if (this->_metrics && count > 0) {
+        this->_metrics->add_queue_depth(count);
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_subtract_queue_depth(std::size_t const count) {
+    if (this->_metrics && count > 0) {
+        this->_metrics->subtract_queue_depth(count);
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_add_cancellation_count(std::size_t const count) {
+    if (this->_metrics && count > 0) {
+        this->_metrics->add_cancellation_count(count);
+    }
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_unindex_task(std::shared_ptr<task<Canceller>> const &task) {
+    auto const it = this->_task_counts.find(task.get());
+    if (it == this->_task_counts.end()) {
+        return;
+    }
+
+    if (--it->second == 0) {
+        this->_free_task_count_nodes.nodes.emplace_back(this->_task_counts.extract(it));
+    }
+
+    if constexpr (is_hashable_v<Canceller>) {
+        if (auto const &canceller = task->option().canceller) {
+            auto const range = this->_canceller_tasks.equal_range(canceller.value());
+            for (auto canceller_it = range.first; canceller_it != range.second; ++canceller_it) {
+                if (canceller_it->second == task.get()) {
+                    if constexpr (_is_canceller_node_reusable) {
+                        this->_free_canceller_task_nodes.nodes.emplace_back(
+                            this->_canceller_tasks.extract(canceller_it));
+                    } else {
+                        this->_canceller_tasks.erase(canceller_it);
+                    }
+                    break;
+                }
+            }
+        }
+    }
 }
 
 template <typename Canceller>
 std::shared_ptr<task<Canceller>> task_queue<Canceller>::_pop_task() {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    for (auto &deque : this->_tasks) {
-        if (!deque.empty()) {
-            auto task = deque.front();
-            deque.pop_front();
+    for (std::size_t idx = 0; idx < this->_tasks.size(); ++idx) {
+        if (auto task = this->_pop_task_at(idx)) {
             return task;
         }
     }
     return nullptr;
 }
 
+template <typename Canceller>
+std::shared_ptr<task<Canceller>> task_queue<Canceller>::_pop_task_at(std::size_t const idx) {
+    std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+
+    std::optional<std::chrono::steady_clock::time_point> now = std::nullopt;
+
+    {
+        auto &heap = this->_deadline_tasks.at(idx);
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end());
+            auto task = std::move(heap.back().queued);
+            heap.pop_back();
+            this->_release(idx, 1);
+            this->_subtract_queue_depth(1);
+
+            if (!now) {
+                now = std::chrono::steady_clock::now();
+            }
+
+            if (!this->_drop_if_needed(task, now.value())) {
+                return task;
+            }
+        }
+
+        auto &deque = this->_tasks.at(idx);
+
+        while (!deque.empty()) {
+            auto task = std::move(deque.front());
+            deque.pop_front();
+            this->_release(idx, 1);
+            this->_subtract_queue_depth(1);
+
+            if (task->option().deadline && !now) {
+                now = std::chrono::steady_clock::now();
+            }
+
+            if (!this->_drop_if_needed(task, now.value_or(std::chrono::steady_clock::time_point{}))) {
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_drop_if_needed(std::shared_ptr<task<Canceller>> const &task,
+                                            std::chrono::steady_clock::time_point const &now) {
+    if (!task->is_canceled()) {
+        auto const &deadline = task->option().deadline;
+        if (!deadline || now <= deadline.value()) {
+            return false;
+        }
+
+        task->cancel();
+
+        if (this->_metrics) {
+            this->_metrics->add_expiration_count(1);
+        }
+    }
+
+    this->_unindex_task(task);
+    return true;
+}
+
 template <typename Canceller>
 void task_queue<Canceller>::_begin_next_task_if_needed() {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    if (!this->_current_task && !this->_suspended) {
-        if (auto const task = this->_pop_task()) {
-            this->_current_task = task;
+    this->_drain_submissions();
 
-            std::thread thread{[weak_task = to_weak(task), weak_queue = this->_weak_queue]() {
-                if (auto const task = weak_task.lock()) {
-                    task->execute();
+    while (!this->_free_lanes.empty() && !this->_suspended) {
+        auto task = this->_pop_task();
+        if (!task) {
+            break;
+        }
 
-                    if (auto const queue = weak_queue.lock()) {
-                        queue->_task_did_finish_on_bg(task);
-                    }
-                }
-            }};
+        auto const priority = task->option().priority;
+        auto const lane = this->_free_lanes.back();
+        this->_free_lanes.pop_back();
+
+        auto &batch = this->_batches.at(lane);
+        batch.emplace_back(std::move(task));
+
+        while (batch.size() < this->_batch_size) {
+            if (auto next_task = this->_pop_task_at(priority)) {
+                batch.emplace_back(std::move(next_task));
+            } else {
+                break;
+            }
+        }
+
+        this->_current_tasks.insert(this->_current_tasks.end(), batch.begin(), batch.end());
+
+        this->_executor->execute(priority,
+                                 [weak_queue = this->_weak_queue, lane, metrics = this->_metrics]() {
+                                     if (auto const queue = weak_queue.lock()) {
+                                         queue->_execute_batch_on_bg(lane, metrics);
+                                     }
+                                 });
+    }
+
+    this->_notify_capacity_if_needed();
+    this->_notify_if_finished();
+}
 
-            thread.detach();
+template <typename Canceller>
+void task_queue<Canceller>::_execute_batch_on_bg(std::size_t const lane, task_queue_metrics_ptr const &metrics) {
+    // the batch of the lane is not touched by others until the lane is freed.
+    for (auto const &task : this->_batches.at(lane)) {
+        if (metrics) {
+            _execute_with_metrics(*task, *metrics);
+        } else {
+            task->execute();
         }
+
+        task->_is_finished = true;
     }
+
+    this->_batch_did_finish_on_bg(lane);
 }
 
 template <typename Canceller>
-void task_queue<Canceller>::_task_did_finish_on_bg(std::shared_ptr<task<Canceller>> const &pre_task) {
+void task_queue<Canceller>::_batch_did_finish_on_bg(std::size_t const lane) {
     std::lock_guard<std::recursive_mutex> lock(this->_mutex);
 
-    if (this->_current_task == pre_task) {
-        this->_current_task = nullptr;
+    auto &batch = this->_batches.at(lane);
+
+    for (auto const &pre_task : batch) {
+        if (auto const idx = index(this->_current_tasks, pre_task)) {
+            erase_at(this->_current_tasks, idx.value());
+            this->_unindex_task(pre_task);
+        }
     }
 
+    batch.clear();
+    batch.reserve(this->_batch_size);
+    this->_free_lanes.emplace_back(lane);
+
     this->_begin_next_task_if_needed();
 }
 
+template <typename Canceller>
+void task_queue<Canceller>::_execute_with_metrics(task<Canceller> &task, task_queue_metrics &metrics) {
+    using clock = std::chrono::steady_clock;
+
+    auto const priority = task.option().priority;
+    auto const begin = clock::now();
+
+    if (auto const submitted_time = task._submitted_time.load(); submitted_time != 0) {
+        metrics.record_waiting(priority, begin - clock::time_point(clock::duration(submitted_time)));
+    }
+
+    task.execute();
+
+    metrics.record_execution(priority, clock::now() - begin);
+}
+
+template <typename Canceller>
+bool task_queue<Canceller>::_is_waiting_finished() const {
+    return this->_suspended || !this->is_operating();
+}
+
+template <typename Canceller>
+void task_queue<Canceller>::_notify_if_finished() {
+    if (!this->is_operating()) {
+        this->_finished_condition.notify_all();
+    }
+}
+
 template <typename Canceller>
 std::shared_ptr<task_queue<Canceller>> task_queue<Canceller>::make_shared(std::size_t const priority_count) {
-    auto shared = std::shared_ptr<task_queue>(new task_queue{priority_count});
+    return make_shared(priority_count, 1);
+}
+
+template <typename Canceller>
+std::shared_ptr<task_queue<Canceller>> task_queue<Canceller>::make_shared(std::size_t const priority_count,
+                                                                          executable_ptr const &executor) {
+    return make_shared(priority_count, 1, executor);
+}
+
+template <typename Canceller>
+std::shared_ptr<task_queue<Canceller>> task_queue<Canceller>::make_shared(std::size_t const priority_count,
+                                                                          std::size_t const concurrency) {
+    return make_shared(priority_count, concurrency, thread_pool_executor::make_shared(concurrency));
+}
+
+template <typename Canceller>
+std::shared_ptr<task_queue<Canceller>> task_queue<Canceller>::make_shared(std::size_t const priority_count,
+                                                                          std::size_t const concurrency,
+                                                                          executable_ptr const &executor) {
+    auto shared = std::shared_ptr<task_queue>(new task_queue{priority_count, concurrency, executor});
     shared->_weak_queue = shared;
     return shared;
 }
@@ -12,6 +12,13 @@ struct thread {
     static void sleep_for_timeinterval(double const);
 
     static void perform_async_on_main(std::function<void(void)> &&);
+    // an exception thrown by the handler is rethrown on the calling thread.
     static void perform_sync_on_main(std::function<void(void)> &&);
+
+#if !defined(__APPLE__)
+    // outside of apple platforms, the handlers are posted to run_loop::main(). the owner of the loop performs them with
+    // it or with run_loop::run().
+    static void process_main_queue();
+#endif
 };
 }  // namespace yas
@@ -4,6 +4,8 @@
 
 #include "thread.h"
 
+#include <exception>
+
 #import <Foundation/Foundation.h>
 
 using namespace yas;
@@ -22,5 +24,18 @@ void thread::perform_async_on_main(std::function<void(void)> &&handler) {
 
 void thread::perform_sync_on_main(std::function<void(void)> &&handler) {
     assert(!is_main());
-    dispatch_sync(dispatch_get_main_queue(), [handler = std::move(handler)] { handler(); });
+
+    std::exception_ptr exception = nullptr;
+
+    dispatch_sync(dispatch_get_main_queue(), [&handler, &exception] {
+        try {
+            handler();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+    });
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
 }
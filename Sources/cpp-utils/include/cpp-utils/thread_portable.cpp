@@ -0,0 +1,55 @@
+//
+//  thread_portable.cpp
+//
+
+#if !defined(__APPLE__)
+
+#include "thread.h"
+
+#include "run_loop.h"
+
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace yas;
+
+bool thread::is_main() {
+    return run_loop::main()->is_current();
+}
+
+void thread::sleep_for_timeinterval(double const interval) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+}
+
+void thread::perform_async_on_main(std::function<void(void)> &&handler) {
+    run_loop::main()->execute([handler = std::move(handler)] { handler(); });
+}
+
+void thread::perform_sync_on_main(std::function<void(void)> &&handler) {
+    assert(!is_main());
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    run_loop::main()->execute([&handler, &promise] {
+        try {
+            handler();
+            promise.set_value();
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    });
+
+    // rethrows the exception of the handler on the calling thread.
+    future.get();
+}
+
+void thread::process_main_queue() {
+    assert(is_main());
+
+    run_loop::main()->process();
+}
+
+#endif
@@ -0,0 +1,105 @@
+//
+//  timer.cpp
+//
+
+#include "timer.h"
+
+#include "thread.h"
+#include "timer_service.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <optional>
+
+using namespace yas;
+
+namespace yas::timer_utils {
+// a non-positive interval is replaced with 0.1 milliseconds as NSTimer does.
+static std::chrono::microseconds to_interval(double const time_interval) {
+    return std::chrono::microseconds(std::max(std::llround(time_interval * 1000000.0), 100LL));
+}
+
+// the state shared with the handler posted to the main thread, which may be called after the timer is invalidated.
+struct main_delivery {
+    std::function<void(void)> const handler;
+    std::atomic<bool> is_valid = true;
+    std::atomic<bool> is_posted = false;
+
+    main_delivery(std::function<void(void)> &&handler) : handler(std::move(handler)) {
+    }
+};
+
+static timer_service::handler_f make_calling_handler(std::function<void(void)> &&handler) {
+    return [handler = std::move(handler)] {
+        if (handler) {
+            handler();
+        }
+    };
+}
+
+static timer_service::handler_f make_posting_handler(std::shared_ptr<main_delivery> const &main_delivery) {
+    return [main_delivery] {
+        if (!main_delivery->is_valid || main_delivery->is_posted.exchange(true)) {
+            return;
+        }
+
+        thread::perform_async_on_main([main_delivery] {
+            main_delivery->is_posted = false;
+
+            if (main_delivery->is_valid && main_delivery->handler) {
+                main_delivery->handler();
+            }
+        });
+    };
+}
+}  // namespace yas::timer_utils
+
+struct timer::impl {
+    timer_service_ptr const _service = timer_service::shared();
+    std::optional<timer_id> _timer_id;
+    std::shared_ptr<timer_utils::main_delivery> _main_delivery = nullptr;
+
+    impl(double const time_interval, bool const repeats, std::function<void(void)> &&handler,
+         timer_delivery const delivery) {
+        auto const interval = timer_utils::to_interval(time_interval);
+
+        timer_service::handler_f service_handler;
+        if (delivery == timer_delivery::main) {
+            this->_main_delivery = std::make_shared<timer_utils::main_delivery>(std::move(handler));
+            service_handler = timer_utils::make_posting_handler(this->_main_delivery);
+        } else {
+            service_handler = timer_utils::make_calling_handler(std::move(handler));
+        }
+
+        if (repeats) {
+            this->_timer_id = this->_service->schedule_repeating(interval, std::move(service_handler));
+        } else {
+            this->_timer_id = this->_service->schedule(interval, std::move(service_handler));
+        }
+    }
+
+    ~impl() {
+        this->invalidate();
+    }
+
+    void invalidate() {
+        if (this->_main_delivery) {
+            this->_main_delivery->is_valid = false;
+        }
+
+        if (this->_timer_id) {
+            this->_service->cancel(this->_timer_id.value());
+            this->_timer_id = std::nullopt;
+        }
+    }
+};
+
+timer::timer(double const time_interval, bool const repeats, std::function<void(void)> handler,
+             timer_delivery const delivery)
+    : _impl(std::make_unique<impl>(time_interval, repeats, std::move(handler), delivery)) {
+}
+
+void timer::invalidate() {
+    this->_impl->invalidate();
+}
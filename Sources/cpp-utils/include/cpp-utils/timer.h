@@ -5,16 +5,39 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 namespace yas {
+enum class timer_delivery {
+    // the handler is called on the main thread through thread::perform_async_on_main. the fires while a handler is
+    // waiting to be called are skipped.
+    main,
+    // the handler is called on the thread of the shared timer_service.
+    service,
+};
+
 struct timer final {
     class impl;
 
-    timer(double const time_interval, bool const repeats, std::function<void(void)> handler);
+    // the handler is called on the main run loop on apple platforms, and on the thread of the timer service elsewhere
+    // as there is no main run loop without processing run_loop::main().
+#if defined(__APPLE__)
+    static constexpr timer_delivery default_delivery = timer_delivery::main;
+#else
+    static constexpr timer_delivery default_delivery = timer_delivery::service;
+#endif
+
+    timer(double const time_interval, bool const repeats, std::function<void(void)> handler,
+          timer_delivery const delivery = default_delivery);
 
     timer(timer &&) = default;
     timer &operator=(timer &&) = default;
 
+    // the handler is not called after this returns, unless it is called in the handler.
+    // with the service delivery, it blocks until the handler running on the service thread returns. so it must not be
+    // called while the handler is waiting for the calling thread, or they deadlock.
+    // with the main delivery, it does not block. a handler already running on the main thread may continue to run if it
+    // is called on another thread.
     void invalidate();
 
    private:
@@ -0,0 +1,294 @@
+//
+//  timer_service.cpp
+//
+
+#include "timer_service.h"
+
+#include "timer_wheel.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace yas;
+
+namespace yas::timer_service_utils {
+enum class timer_state {
+    idle,
+    scheduled,
+    firing,
+    // canceled while firing.
+    canceled,
+};
+
+struct timer_node {
+    timer_service::handler_f handler;
+    timer_wheel::tick_t deadline = 0;
+    // zero if not repeating.
+    timer_wheel::tick_t interval = 0;
+    uint32_t generation = 0;
+    timer_state state = timer_state::idle;
+};
+}  // namespace yas::timer_service_utils
+
+#pragma mark - resource
+
+struct timer_service::resource {
+    using tick_t = timer_wheel::tick_t;
+    using timer_node = timer_service_utils::timer_node;
+    using timer_state = timer_service_utils::timer_state;
+
+    std::chrono::steady_clock::time_point const origin = std::chrono::steady_clock::now();
+    std::thread::id thread_id;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable fired_condition;
+    timer_wheel wheel;
+    // a deque keeps the nodes in place while a handler is called without the lock.
+    std::deque<timer_node> nodes;
+    std::vector<timer_wheel::index_t> free_indices;
+    std::size_t timer_count = 0;
+    std::optional<tick_t> waiting_deadline = std::nullopt;
+    std::optional<timer_wheel::index_t> firing_index = std::nullopt;
+    bool is_waiting = false;
+    bool is_continue = true;
+
+    tick_t now() const {
+        return static_cast<tick_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->origin)
+                .count());
+    }
+
+    timer_id schedule(tick_t const delay, tick_t const interval, handler_f &&handler) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        timer_wheel::index_t idx;
+
+        if (this->free_indices.empty()) {
+            idx = static_cast<timer_wheel::index_t>(this->nodes.size());
+            this->nodes.emplace_back();
+        } else {
+            idx = this->free_indices.back();
+            this->free_indices.pop_back();
+        }
+
+        auto &node = this->nodes[idx];
+        node.handler = std::move(handler);
+        node.deadline = this->now() + delay;
+        node.interval = interval;
+        node.state = timer_state::scheduled;
+
+        this->wheel.insert(idx, node.deadline);
+        ++this->timer_count;
+
+        if (this->is_waiting && (!this->waiting_deadline || node.deadline < *this->waiting_deadline)) {
+            this->condition.notify_one();
+        }
+
+        return timer_id{.index = idx, .generation = node.generation};
+    }
+
+    bool cancel(timer_id const &timer_id) {
+        handler_f handler;
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        if (this->nodes.size() <= timer_id.index) {
+            return false;
+        }
+
+        auto &node = this->nodes[timer_id.index];
+
+        if (node.generation != timer_id.generation) {
+            return false;
+        }
+
+        switch (node.state) {
+            case timer_state::scheduled:
+                this->wheel.remove(timer_id.index);
+                handler = std::move(node.handler);
+                this->release(timer_id.index);
+                --this->timer_count;
+                break;
+            case timer_state::firing: {
+                // a timer firing once is already finished. a repeating one is not rescheduled.
+                bool const is_repeating = node.interval > 0;
+
+                if (is_repeating) {
+                    node.state = timer_state::canceled;
+                    ++node.generation;
+                    --this->timer_count;
+                }
+
+                if (std::this_thread::get_id() != this->thread_id) {
+                    this->fired_condition.wait(lock, [this, &timer_id] { return this->firing_index != timer_id.index; });
+                }
+
+                return is_repeating;
+            }
+            default:
+                return false;
+        }
+
+        // the handler is destroyed without the lock in case it cancels another timer.
+        lock.unlock();
+
+        return true;
+    }
+
+    void release(timer_wheel::index_t const idx) {
+        auto &node = this->nodes[idx];
+        node.state = timer_state::idle;
+        ++node.generation;
+        this->free_indices.push_back(idx);
+    }
+
+    void run() {
+        std::vector<timer_wheel::index_t> expired;
+        std::vector<timer_id> due_ids;
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (this->is_continue) {
+            expired.clear();
+            this->wheel.advance(this->now(), expired);
+
+            if (expired.empty()) {
+                this->waiting_deadline = this->wheel.next_deadline();
+                this->is_waiting = true;
+
+                if (this->waiting_deadline) {
+                    this->condition.wait_until(lock, this->origin + std::chrono::microseconds(*this->waiting_deadline));
+                } else {
+                    this->condition.wait(lock);
+                }
+
+                this->is_waiting = false;
+                continue;
+            }
+
+            // the expired timers may be canceled while firing the others.
+            due_ids.clear();
+            for (auto const idx : expired) {
+                due_ids.push_back(timer_id{.index = idx, .generation = this->nodes[idx].generation});
+            }
+
+            for (auto const &timer_id : due_ids) {
+                this->fire(timer_id, lock);
+
+                if (!this->is_continue) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void fire(timer_id const &timer_id, std::unique_lock<std::mutex> &lock) {
+        auto const idx = timer_id.index;
+        auto &node = this->nodes[idx];
+
+        if (node.generation != timer_id.generation || node.state != timer_state::scheduled) {
+            return;
+        }
+
+        node.state = timer_state::firing;
+        this->firing_index = idx;
+
+        lock.unlock();
+        node.handler();
+        lock.lock();
+
+        if (node.state == timer_state::firing && node.interval > 0) {
+            auto const now = this->now();
+            auto deadline = node.deadline + node.interval;
+
+            if (deadline <= now) {
+                deadline += ((now - deadline) / node.interval + 1) * node.interval;
+            }
+
+            node.deadline = deadline;
+            node.state = timer_state::scheduled;
+            this->wheel.insert(idx, deadline);
+        } else {
+            if (node.state == timer_state::firing) {
+                --this->timer_count;
+            }
+
+            auto handler = std::move(node.handler);
+            this->release(idx);
+
+            lock.unlock();
+            handler = nullptr;
+            lock.lock();
+        }
+
+        this->firing_index = std::nullopt;
+        this->fired_condition.notify_all();
+    }
+};
+
+#pragma mark - timer_service
+
+timer_service::timer_service() : _resource(std::make_shared<resource>()) {
+    std::thread thread{[resource = this->_resource] { resource->run(); }};
+    this->_resource->thread_id = thread.get_id();
+    thread.detach();
+}
+
+timer_service::~timer_service() {
+    {
+        std::lock_guard<std::mutex> lock(this->_resource->mutex);
+        this->_resource->is_continue = false;
+    }
+
+    this->_resource->condition.notify_all();
+}
+
+timer_id timer_service::schedule(std::chrono::microseconds const &delay, handler_f &&handler) {
+    if (!handler) {
+        throw std::invalid_argument("timer_service schedule() - handler is null.");
+    }
+
+    auto const ticks = std::max(delay.count(), std::chrono::microseconds::rep{0});
+    return this->_resource->schedule(static_cast<timer_wheel::tick_t>(ticks), 0, std::move(handler));
+}
+
+timer_id timer_service::schedule_repeating(std::chrono::microseconds const &interval, handler_f &&handler) {
+    if (!handler) {
+        throw std::invalid_argument("timer_service schedule_repeating() - handler is null.");
+    }
+
+    if (interval.count() <= 0) {
+        throw std::invalid_argument("timer_service schedule_repeating() - interval is not positive.");
+    }
+
+    auto const ticks = static_cast<timer_wheel::tick_t>(interval.count());
+    return this->_resource->schedule(ticks, ticks, std::move(handler));
+}
+
+bool timer_service::cancel(timer_id const &timer_id) {
+    return this->_resource->cancel(timer_id);
+}
+
+std::size_t timer_service::timer_count() const {
+    std::lock_guard<std::mutex> lock(this->_resource->mutex);
+    return this->_resource->timer_count;
+}
+
+bool timer_service::is_service_thread() const {
+    return std::this_thread::get_id() == this->_resource->thread_id;
+}
+
+timer_service_ptr const &timer_service::shared() {
+    static timer_service_ptr const service = make_shared();
+    return service;
+}
+
+timer_service_ptr timer_service::make_shared() {
+    return timer_service_ptr(new timer_service{});
+}
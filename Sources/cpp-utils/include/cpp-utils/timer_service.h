@@ -0,0 +1,54 @@
+//
+//  timer_service.h
+//
+
+#pragma once
+
+#include <cpp-utils/small_function.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace yas {
+class timer_service;
+using timer_service_ptr = std::shared_ptr<timer_service>;
+
+struct timer_id final {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(timer_id const &) const = default;
+};
+
+// runs the handlers of many timers on one thread of its own. the timers are kept on a hierarchical timer wheel of
+// microsecond ticks, so scheduling and cancellation take a constant time regardless of the number of the timers.
+// the handlers are called one at a time on the thread and should return soon.
+struct timer_service final {
+    using handler_f = small_function<void(void)>;
+
+    ~timer_service();
+
+    // the handler is called once after the delay.
+    timer_id schedule(std::chrono::microseconds const &delay, handler_f &&);
+    // the handler is called every interval until canceled. the missed fires are skipped if a handler is late.
+    timer_id schedule_repeating(std::chrono::microseconds const &interval, handler_f &&);
+    // returns false if the timer is already canceled or finished. if the handler is running on the service thread, it
+    // waits for the handler to return, unless it is called from the handler.
+    bool cancel(timer_id const &);
+
+    [[nodiscard]] std::size_t timer_count() const;
+    [[nodiscard]] bool is_service_thread() const;
+
+    // a service shared by the timers of the process.
+    [[nodiscard]] static timer_service_ptr const &shared();
+    static timer_service_ptr make_shared();
+
+   private:
+    class resource;
+
+    std::shared_ptr<resource> const _resource;
+
+    timer_service();
+};
+}  // namespace yas
@@ -0,0 +1,192 @@
+//
+//  timer_wheel.cpp
+//
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+
+using namespace yas;
+
+namespace yas::timer_wheel_utils {
+static timer_wheel::tick_t slot_range(std::size_t const level) {
+    return timer_wheel::tick_t{1} << (level * timer_wheel::slot_bits);
+}
+
+static timer_wheel::tick_t level_range(std::size_t const level) {
+    return timer_wheel::tick_t{1} << ((level + 1) * timer_wheel::slot_bits);
+}
+
+// the level is the highest group of bits which differs between the deadline and the elapsed tick.
+// the distant deadlines beyond the top level are put on the top level and reinserted when the slot is reached.
+static std::size_t level_for(timer_wheel::tick_t const elapsed, timer_wheel::tick_t const deadline) {
+    auto const masked = (elapsed ^ deadline) | (timer_wheel::slot_count - 1);
+    auto const significant = static_cast<std::size_t>(std::bit_width(masked)) - 1;
+    return std::min(significant / timer_wheel::slot_bits, timer_wheel::level_count - 1);
+}
+}  // namespace yas::timer_wheel_utils
+
+timer_wheel::timer_wheel() {
+    this->_heads.fill(null_index);
+}
+
+void timer_wheel::insert(index_t const idx, tick_t const deadline) {
+    if (this->_entries.size() <= idx) {
+        this->_entries.resize(static_cast<std::size_t>(idx) + 1);
+    }
+
+    auto &entry = this->_entries[idx];
+
+    if (entry.is_linked) {
+        this->_unlink(idx);
+        --this->_size;
+    }
+
+    entry.deadline = deadline;
+    this->_link(idx);
+    ++this->_size;
+}
+
+bool timer_wheel::remove(index_t const idx) {
+    if (!this->contains(idx)) {
+        return false;
+    }
+
+    this->_unlink(idx);
+    --this->_size;
+
+    return true;
+}
+
+bool timer_wheel::contains(index_t const idx) const {
+    return idx < this->_entries.size() && this->_entries[idx].is_linked;
+}
+
+std::size_t timer_wheel::size() const {
+    return this->_size;
+}
+
+timer_wheel::tick_t timer_wheel::elapsed() const {
+    return this->_elapsed;
+}
+
+std::optional<timer_wheel::tick_t> timer_wheel::next_deadline() const {
+    if (auto const expiration = this->_next_expiration()) {
+        return expiration->deadline;
+    }
+    return std::nullopt;
+}
+
+void timer_wheel::advance(tick_t const now, std::vector<index_t> &expired) {
+    while (true) {
+        auto const expiration = this->_next_expiration();
+
+        if (!expiration || expiration->deadline > now) {
+            break;
+        }
+
+        this->_elapsed = std::max(this->_elapsed, expiration->deadline);
+
+        std::size_t const list = expiration->level * slot_count + expiration->slot;
+        index_t idx = this->_heads[list];
+
+        // the entries of a slot on the upper levels are cascaded to the lower levels, or expired if they are due.
+        while (idx != null_index) {
+            auto const next = this->_entries[idx].next;
+
+            this->_unlink(idx);
+
+            if (this->_entries[idx].deadline <= this->_elapsed) {
+                expired.push_back(idx);
+                --this->_size;
+            } else {
+                this->_link(idx);
+            }
+
+            idx = next;
+        }
+    }
+
+    this->_elapsed = std::max(this->_elapsed, now);
+}
+
+void timer_wheel::_link(index_t const idx) {
+    auto &entry = this->_entries[idx];
+
+    std::size_t list = pending_list;
+
+    if (entry.deadline > this->_elapsed) {
+        auto const level = timer_wheel_utils::level_for(this->_elapsed, entry.deadline);
+        auto const slot = static_cast<std::size_t>((entry.deadline >> (level * slot_bits)) & (slot_count - 1));
+        list = level * slot_count + slot;
+        this->_occupied[level] |= uint64_t{1} << slot;
+    }
+
+    auto &head = this->_heads[list];
+
+    entry.list = static_cast<uint32_t>(list);
+    entry.prev = null_index;
+    entry.next = head;
+    entry.is_linked = true;
+
+    if (head != null_index) {
+        this->_entries[head].prev = idx;
+    }
+    head = idx;
+}
+
+void timer_wheel::_unlink(index_t const idx) {
+    auto &entry = this->_entries[idx];
+    auto &head = this->_heads[entry.list];
+
+    if (entry.prev != null_index) {
+        this->_entries[entry.prev].next = entry.next;
+    } else {
+        head = entry.next;
+    }
+
+    if (entry.next != null_index) {
+        this->_entries[entry.next].prev = entry.prev;
+    }
+
+    if (head == null_index && entry.list != pending_list) {
+        this->_occupied[entry.list / slot_count] &= ~(uint64_t{1} << (entry.list % slot_count));
+    }
+
+    entry.prev = null_index;
+    entry.next = null_index;
+    entry.is_linked = false;
+}
+
+std::optional<timer_wheel::expiration> timer_wheel::_next_expiration() const {
+    if (this->_heads[pending_list] != null_index) {
+        return expiration{.level = level_count, .slot = 0, .deadline = this->_elapsed};
+    }
+
+    // the entries on a lower level always expire earlier than the ones on the upper levels.
+    for (std::size_t level = 0; level < level_count; ++level) {
+        auto const occupied = this->_occupied[level];
+
+        if (occupied == 0) {
+            continue;
+        }
+
+        auto const slot_range = timer_wheel_utils::slot_range(level);
+        auto const level_range = timer_wheel_utils::level_range(level);
+        // the current slot is searched last. only a distant entry on the top level can be there.
+        auto const next_slot = static_cast<int>((this->_elapsed / slot_range + 1) % slot_count);
+        auto const slot =
+            static_cast<std::size_t>((std::countr_zero(std::rotr(occupied, next_slot)) + next_slot) % slot_count);
+        auto const level_start = this->_elapsed & ~(level_range - 1);
+
+        auto deadline = level_start + slot * slot_range;
+        if (deadline <= this->_elapsed) {
+            deadline += level_range;
+        }
+
+        return expiration{.level = level, .slot = slot, .deadline = deadline};
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,69 @@
+//
+//  timer_wheel.h
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace yas {
+// a hierarchical timer wheel of 64 slots per level. it keeps the entries by their indices and the deadlines in ticks,
+// and inserts and removes them in O(1). it is not thread safe.
+struct timer_wheel final {
+    using tick_t = uint64_t;
+    using index_t = uint32_t;
+
+    static std::size_t constexpr slot_bits = 6;
+    static std::size_t constexpr slot_count = std::size_t{1} << slot_bits;
+    static std::size_t constexpr level_count = 8;
+
+    timer_wheel();
+
+    // the index is chosen by the caller and must not be inserted twice. an elapsed deadline expires at the next advance.
+    void insert(index_t const, tick_t const deadline);
+    // returns false if the index is not inserted.
+    bool remove(index_t const);
+
+    [[nodiscard]] bool contains(index_t const) const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] tick_t elapsed() const;
+    // the earliest tick when any entry expires. it may be earlier than the deadline of the entry for the distant ones.
+    [[nodiscard]] std::optional<tick_t> next_deadline() const;
+
+    // advances to the tick and appends the indices of the expired entries. the earlier deadlines come first.
+    void advance(tick_t const now, std::vector<index_t> &expired);
+
+   private:
+    static index_t constexpr null_index = UINT32_MAX;
+    // the list of the entries that are expired at the insertion.
+    static std::size_t constexpr pending_list = level_count * slot_count;
+
+    struct entry {
+        tick_t deadline = 0;
+        index_t prev = null_index;
+        index_t next = null_index;
+        uint32_t list = 0;
+        bool is_linked = false;
+    };
+
+    struct expiration {
+        // level_count for the pending list.
+        std::size_t level;
+        std::size_t slot;
+        tick_t deadline;
+    };
+
+    std::vector<entry> _entries;
+    std::array<index_t, level_count * slot_count + 1> _heads;
+    std::array<uint64_t, level_count> _occupied{};
+    tick_t _elapsed = 0;
+    std::size_t _size = 0;
+
+    void _link(index_t const);
+    void _unlink(index_t const);
+    [[nodiscard]] std::optional<expiration> _next_expiration() const;
+};
+}  // namespace yas
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -22,6 +23,13 @@ class has_operator_bool {
     static bool constexpr value = decltype(confirm(std::declval<T>()))::value;
 };
 
+template <typename T, typename = void>
+struct is_hashable : std::false_type {};
+template <typename T>
+struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<T const &>()))>> : std::true_type {};
+template <typename T>
+inline constexpr bool is_hashable_v = is_hashable<T>::value;
+
 template <typename T, typename U = void>
 using enable_if_integral_t = typename std::enable_if_t<std::is_integral<T>::value, U>;
 template <typename T, typename U = void>
@@ -14,6 +14,7 @@
 #include <cpp-utils/each_dictionary.h>
 #include <cpp-utils/each_index.h>
 #include <cpp-utils/exception.h>
+#include <cpp-utils/executor.h>
 #include <cpp-utils/fast_each.h>
 #include <cpp-utils/file_manager.h>
 #include <cpp-utils/file_path.h>
@@ -23,13 +24,22 @@
 #include <cpp-utils/identifier.h>
 #include <cpp-utils/index_range.h>
 #include <cpp-utils/lock.h>
+#include <cpp-utils/metrics.h>
+#include <cpp-utils/multi_thread_worker.h>
+#include <cpp-utils/pool_allocator.h>
 #include <cpp-utils/result.h>
+#include <cpp-utils/ring_deque.h>
+#include <cpp-utils/run_loop.h>
+#include <cpp-utils/small_function.h>
 #include <cpp-utils/stl_utils.h>
 #include <cpp-utils/system_path_utils.h>
 #include <cpp-utils/system_time_provider.h>
+#include <cpp-utils/task_future.h>
 #include <cpp-utils/task_queue.h>
 #include <cpp-utils/thread.h>
 #include <cpp-utils/timer.h>
+#include <cpp-utils/timer_service.h>
+#include <cpp-utils/timer_wheel.h>
 #include <cpp-utils/to_bool.h>
 #include <cpp-utils/to_floating_point.h>
 #include <cpp-utils/to_integer.h>
@@ -38,4 +48,5 @@
 #include <cpp-utils/unless.h>
 #include <cpp-utils/url.h>
 #include <cpp-utils/version.h>
+#include <cpp-utils/work_stealing_executor.h>
 #include <cpp-utils/worker.h>
@@ -0,0 +1,398 @@
+//
+//  work_stealing_executor.cpp
+//
+
+#include "work_stealing_executor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "ring_deque.h"
+
+using namespace yas;
+
+#pragma mark - resource
+
+struct work_stealing_executor::resource {
+    using clock = std::chrono::steady_clock;
+
+    struct deques {
+        std::mutex mutex;
+        std::vector<ring_deque<execution_f>> executions;
+
+        deques(std::size_t const priority_count) : executions(priority_count) {
+        }
+    };
+
+    struct timed_execution {
+        clock::time_point time;
+        task_priority_t priority;
+        execution_f execution;
+    };
+
+    std::size_t const priority_count;
+    std::vector<std::unique_ptr<deques>> locals;
+    deques injected;
+
+    std::atomic<std::size_t> pending = 0;
+    std::atomic<std::size_t> sleeping = 0;
+    std::atomic<bool> is_continue = true;
+
+    std::mutex idle_mutex;
+    std::condition_variable idle_condition;
+    std::vector<timed_execution> timed_executions;
+    std::atomic<clock::rep> next_time = clock::time_point::max().time_since_epoch().count();
+
+    resource(std::size_t const thread_count, std::size_t const priority_count)
+        : priority_count(priority_count), injected(priority_count) {
+        for (std::size_t idx = 0; idx < thread_count; ++idx) {
+            this->locals.emplace_back(std::make_unique<deques>(priority_count));
+        }
+    }
+
+    static thread_local resource const *current;
+    static thread_local std::size_t current_index;
+
+    void push(task_priority_t const priority, execution_f &&execution) {
+        std::size_t const idx = std::min(static_cast<std::size_t>(priority), this->priority_count - 1);
+        auto &deques = (current == this) ? *this->locals.at(current_index) : this->injected;
+
+        {
+            std::lock_guard<std::mutex> lock(deques.mutex);
+            deques.executions.at(idx).emplace_back(std::move(execution));
+        }
+
+        ++this->pending;
+
+        if (this->sleeping > 0) {
+            std::lock_guard<std::mutex> lock(this->idle_mutex);
+            this->idle_condition.notify_one();
+        }
+    }
+
+    void push_after(clock::duration const &delay, task_priority_t const priority, execution_f &&execution) {
+        std::lock_guard<std::mutex> lock(this->idle_mutex);
+
+        auto const time = clock::now() + delay;
+
+        this->timed_executions.emplace_back(
+            timed_execution{.time = time, .priority = priority, .execution = std::move(execution)});
+        std::push_heap(this->timed_executions.begin(), this->timed_executions.end(), _is_later);
+
+        this->next_time = this->timed_executions.front().time.time_since_epoch().count();
+        this->idle_condition.notify_one();
+    }
+
+    void run(std::size_t const thread_idx) {
+        current = this;
+        current_index = thread_idx;
+
+        while (this->is_continue) {
+            if (clock::now().time_since_epoch().count() >= this->next_time) {
+                std::lock_guard<std::mutex> lock(this->idle_mutex);
+                this->_move_due_timed_executions();
+            }
+
+            execution_f execution;
+
+            if (this->_pop(thread_idx, execution)) {
+                execution();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(this->idle_mutex);
+
+            this->_move_due_timed_executions();
+
+            if (!this->is_continue) {
+                break;
+            }
+
+            ++this->sleeping;
+
+            if (this->pending == 0) {
+                if (this->timed_executions.empty()) {
+                    this->idle_condition.wait(lock);
+                } else {
+                    this->idle_condition.wait_until(lock, this->timed_executions.front().time);
+                }
+            }
+
+            --this->sleeping;
+        }
+
+        current = nullptr;
+    }
+
+   private:
+    static bool _is_later(timed_execution const &lhs, timed_execution const &rhs) {
+        return lhs.time > rhs.time;
+    }
+
+    // must be called with idle_mutex locked.
+    void _move_due_timed_executions() {
+        auto const now = clock::now();
+
+        while (!this->timed_executions.empty() && this->timed_executions.front().time <= now) {
+            std::pop_heap(this->timed_executions.begin(), this->timed_executions.end(), _is_later);
+            auto timed = std::move(this->timed_executions.back());
+            this->timed_executions.pop_back();
+
+            std::size_t const idx = std::min(static_cast<std::size_t>(timed.priority), this->priority_count - 1);
+            {
+                std::lock_guard<std::mutex> lock(this->injected.mutex);
+                this->injected.executions.at(idx).emplace_back(std::move(timed.execution));
+            }
+            ++this->pending;
+        }
+
+        this->next_time = this->timed_executions.empty()
+                              ? clock::time_point::max().time_since_epoch().count()
+                              : this->timed_executions.front().time.time_since_epoch().count();
+    }
+
+    bool _pop(std::size_t const thread_idx, execution_f &execution) {
+        if (this->pending == 0) {
+            return false;
+        }
+
+        std::size_t const thread_count = this->locals.size();
+
+        for (std::size_t priority = 0; priority < this->priority_count; ++priority) {
+            // the newest of its own for locality.
+            {
+                auto &own = *this->locals.at(thread_idx);
+                std::lock_guard<std::mutex> lock(own.mutex);
+                auto &deque = own.executions.at(priority);
+                if (!deque.empty()) {
+                    execution = std::move(deque.back());
+                    deque.pop_back();
+                    --this->pending;
+                    return true;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(this->injected.mutex);
+                auto &deque = this->injected.executions.at(priority);
+                if (!deque.empty()) {
+                    execution = std::move(deque.front());
+                    deque.pop_front();
+                    --this->pending;
+                    return true;
+                }
+            }
+
+            // the oldest of the others.
+            for (std::size_t offset = 1; offset < thread_count; ++offset) {
+                auto &victim = *this->locals.at((thread_idx + offset) % thread_count);
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                auto &deque = victim.executions.at(priority);
+                if (!deque.empty()) {
+                    execution = std::move(deque.front());
+                    deque.pop_front();
+                    --this->pending;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+};
+
+thread_local work_stealing_executor::resource const *work_stealing_executor::resource::current = nullptr;
+thread_local std::size_t work_stealing_executor::resource::current_index = 0;
+
+#pragma mark - work_stealing_executor
+
+work_stealing_executor::work_stealing_executor(std::size_t const thread_count, std::size_t const priority_count)
+    : _resource(std::make_shared<resource>(thread_count, priority_count)) {
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        std::thread thread{[resource = this->_resource, idx] { resource->run(idx); }};
+        thread.detach();
+    }
+}
+
+work_stealing_executor::~work_stealing_executor() {
+    this->_resource->is_continue = false;
+
+    std::lock_guard<std::mutex> lock(this->_resource->idle_mutex);
+    this->_resource->idle_condition.notify_all();
+}
+
+void work_stealing_executor::execute(execution_f &&execution) {
+    this->_resource->push(0, std::move(execution));
+}
+
+void work_stealing_executor::execute(task_priority_t const priority, execution_f &&execution) {
+    this->_resource->push(priority, std::move(execution));
+}
+
+void work_stealing_executor::execute_after(std::chrono::steady_clock::duration const &delay,
+                                           task_priority_t const priority, execution_f &&execution) {
+    this->_resource->push_after(delay, priority, std::move(execution));
+}
+
+std::size_t work_stealing_executor::thread_count() const {
+    return this->_resource->locals.size();
+}
+
+std::size_t work_stealing_executor::priority_count() const {
+    return this->_resource->priority_count;
+}
+
+bool work_stealing_executor::is_executor_thread() const {
+    return resource::current == this->_resource.get();
+}
+
+work_stealing_executor_ptr work_stealing_executor::make_shared(std::size_t const thread_count,
+                                                               std::size_t const priority_count) {
+    if (priority_count == 0) {
+        throw std::invalid_argument("work_stealing_executor - priority_count is zero.");
+    }
+
+    std::size_t const count = thread_count > 0 ? thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+    return work_stealing_executor_ptr(new work_stealing_executor{count, priority_count});
+}
+
+#pragma mark - work_stealing_worker
+
+namespace yas::work_stealing_utils {
+struct worker_task {
+    std::weak_ptr<work_stealing_executor> const weak_executor;
+    std::shared_ptr<std::atomic<bool>> const is_continue;
+    task_priority_t const priority;
+    std::chrono::milliseconds const sleep_duration;
+    workable::task_f const task;
+    std::atomic<bool> is_sleeping = false;
+    std::atomic<bool> is_woken = false;
+
+    worker_task(work_stealing_executor_ptr const &executor, std::shared_ptr<std::atomic<bool>> const &is_continue,
+                task_priority_t const priority, std::chrono::milliseconds const &sleep_duration,
+                workable::task_f const &task)
+        : weak_executor(executor),
+          is_continue(is_continue),
+          priority(priority),
+          sleep_duration(sleep_duration),
+          task(task) {
+    }
+};
+
+static void process(std::shared_ptr<worker_task> const &worker_task) {
+    if (!*worker_task->is_continue) {
+        return;
+    }
+
+    worker_task->is_woken = false;
+
+    auto const result = worker_task->task();
+
+    auto const executor = worker_task->weak_executor.lock();
+    if (!executor || !*worker_task->is_continue) {
+        return;
+    }
+
+    switch (result) {
+        case workable::task_result::processed:
+            executor->execute(worker_task->priority, [worker_task] { process(worker_task); });
+            break;
+        case workable::task_result::unprocessed:
+            // either the timer or a wake resumes the sleeping task.
+            worker_task->is_sleeping = true;
+
+            if (worker_task->is_woken && worker_task->is_sleeping.exchange(false)) {
+                executor->execute(worker_task->priority, [worker_task] { process(worker_task); });
+                break;
+            }
+
+            executor->execute_after(worker_task->sleep_duration, worker_task->priority, [worker_task] {
+                if (worker_task->is_sleeping.exchange(false)) {
+                    process(worker_task);
+                }
+            });
+            break;
+        case workable::task_result::completed:
+            break;
+    }
+}
+
+static void wake(std::shared_ptr<worker_task> const &worker_task) {
+    worker_task->is_woken = true;
+
+    if (!worker_task->is_sleeping.exchange(false)) {
+        return;
+    }
+
+    if (auto const executor = worker_task->weak_executor.lock()) {
+        executor->execute(worker_task->priority, [worker_task] { process(worker_task); });
+    }
+}
+}  // namespace yas::work_stealing_utils
+
+work_stealing_worker::work_stealing_worker(work_stealing_executor_ptr const &executor,
+                                           std::chrono::milliseconds const &duration)
+    : _executor(executor), _sleep_duration(duration) {
+    if (!executor) {
+        throw std::invalid_argument("work_stealing_worker - executor is null.");
+    }
+}
+
+work_stealing_worker::~work_stealing_worker() {
+    this->stop();
+}
+
+void work_stealing_worker::add_task(uint32_t const priority, task_f &&task) {
+    if (this->_is_continue) {
+        throw std::runtime_error("worker add_task() - already started.");
+    }
+
+    this->_tasks.emplace(priority, std::move(task));
+}
+
+void work_stealing_worker::start() {
+    if (this->_is_continue) {
+        throw std::runtime_error("worker start() - already started.");
+    }
+
+    if (this->_tasks.size() == 0) {
+        throw std::runtime_error("worker start() - task is empty.");
+    }
+
+    this->_is_continue = std::make_shared<std::atomic<bool>>(true);
+
+    for (auto const &pair : this->_tasks) {
+        auto worker_task = std::make_shared<work_stealing_utils::worker_task>(
+            this->_executor, this->_is_continue, pair.first, this->_sleep_duration, pair.second);
+
+        this->_worker_tasks.emplace_back(worker_task);
+
+        this->_executor->execute(pair.first, [worker_task] { work_stealing_utils::process(worker_task); });
+    }
+}
+
+void work_stealing_worker::stop() {
+    if (this->_is_continue) {
+        *this->_is_continue = false;
+        this->_is_continue = nullptr;
+        this->_worker_tasks.clear();
+    }
+}
+
+void work_stealing_worker::wake() {
+    for (auto const &worker_task : this->_worker_tasks) {
+        work_stealing_utils::wake(worker_task);
+    }
+}
+
+work_stealing_worker_ptr work_stealing_worker::make_shared(work_stealing_executor_ptr const &executor) {
+    return work_stealing_worker::make_shared(executor, std::chrono::milliseconds{10});
+}
+
+work_stealing_worker_ptr work_stealing_worker::make_shared(work_stealing_executor_ptr const &executor,
+                                                           std::chrono::milliseconds const &duration) {
+    return work_stealing_worker_ptr(new work_stealing_worker{executor, duration});
+}
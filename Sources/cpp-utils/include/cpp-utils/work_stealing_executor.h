@@ -0,0 +1,71 @@
+//
+//  work_stealing_executor.h
+//
+
+#pragma once
+
+#include <cpp-utils/executor.h>
+#include <cpp-utils/worker.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+
+namespace yas::work_stealing_utils {
+struct worker_task;
+}
+
+namespace yas {
+class work_stealing_executor;
+using work_stealing_executor_ptr = std::shared_ptr<work_stealing_executor>;
+class work_stealing_worker;
+using work_stealing_worker_ptr = std::shared_ptr<work_stealing_worker>;
+
+// each thread has its own deques per priority. an execution requested on a thread of the executor is a continuation
+// and is pushed to the deques of that thread. idle threads steal the oldest executions from the others.
+struct work_stealing_executor final : executable {
+    ~work_stealing_executor();
+
+    void execute(execution_f &&) override;
+    void execute(task_priority_t const, execution_f &&) override;
+    void execute_after(std::chrono::steady_clock::duration const &, task_priority_t const, execution_f &&);
+
+    [[nodiscard]] std::size_t thread_count() const;
+    [[nodiscard]] std::size_t priority_count() const;
+    [[nodiscard]] bool is_executor_thread() const;
+
+    // thread_count 0 means std::thread::hardware_concurrency().
+    static work_stealing_executor_ptr make_shared(std::size_t const thread_count = 0,
+                                                  std::size_t const priority_count = 1);
+
+   private:
+    class resource;
+
+    std::shared_ptr<resource> const _resource;
+
+    work_stealing_executor(std::size_t const thread_count, std::size_t const priority_count);
+};
+
+// a workable whose tasks run on a work_stealing_executor. each task is executed independently, again at once when it
+// is processed and after the sleep duration or a wake when it is unprocessed.
+struct work_stealing_worker final : workable {
+    ~work_stealing_worker();
+
+    void add_task(uint32_t const priority, task_f &&) override;
+    void start() override;
+    void stop() override;
+    void wake() override;
+
+    static work_stealing_worker_ptr make_shared(work_stealing_executor_ptr const &);
+    static work_stealing_worker_ptr make_shared(work_stealing_executor_ptr const &, std::chrono::milliseconds const &);
+
+   private:
+    work_stealing_executor_ptr const _executor;
+    std::chrono::milliseconds const _sleep_duration;
+    std::multimap<uint32_t, task_f> _tasks;
+    std::shared_ptr<std::atomic<bool>> _is_continue = nullptr;
+    std::vector<std::shared_ptr<work_stealing_utils::worker_task>> _worker_tasks;
+
+    work_stealing_worker(work_stealing_executor_ptr const &, std::chrono::milliseconds const &);
+};
+}  // namespace yas
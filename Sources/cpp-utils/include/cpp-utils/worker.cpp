@@ -4,7 +4,10 @@
 
 #include "worker.h"
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "stl_utils.h"
@@ -12,6 +15,17 @@
 using namespace yas;
 
 namespace yas::worker_utils {
+struct task_entry {
+    identifier const id;
+    uint32_t const priority;
+    workable::task_f const task;
+    std::atomic<bool> is_removed{false};
+
+    task_entry(identifier const &id, uint32_t const priority, workable::task_f const &task)
+        : id(id), priority(priority), task(task) {
+    }
+};
+
 bool process(std::vector<workable::task_f> &tasks) {
     bool processed = false;
     std::vector<std::size_t> completed;
@@ -40,6 +54,29 @@ bool process(std::vector<workable::task_f> &tasks) {
 
     return processed;
 }
+
+bool process(std::vector<std::shared_ptr<worker_utils::task_entry>> const &entries,
+             std::vector<identifier> &completed_ids) {
+    for (auto const &entry : entries) {
+        if (entry->is_removed) {
+            continue;
+        }
+
+        auto const result = entry->task();
+
+        if (result == workable::task_result::processed) {
+            std::this_thread::yield();
+            return true;
+        } else if (result == workable::task_result::completed) {
+            completed_ids.emplace_back(entry->id);
+        }
+    }
+
+    return false;
+}
+
+static std::size_t constexpr spin_count = 64;
+static std::size_t constexpr yield_count = 16;
 }  // namespace yas::worker_utils
 
 #pragma mark - resource
@@ -47,9 +84,94 @@ bool process(std::vector<workable::task_f> &tasks) {
 struct workable::resource {
     std::vector<task_f> tasks;
     std::atomic<bool> is_continue{true};
+    std::atomic<bool> is_woken{false};
+    std::atomic<bool> is_parked{false};
+    std::mutex mutex;
+    std::condition_variable condition;
 
     resource(std::vector<task_f> &&tasks) : tasks(std::move(tasks)) {
     }
+
+    resource(std::vector<std::shared_ptr<worker_utils::task_entry>> &&entries) : _entries(std::move(entries)) {
+    }
+
+    // keeps the entries in order of priority and then of insertion.
+    void insert_entry(std::shared_ptr<worker_utils::task_entry> const &entry) {
+        {
+            std::lock_guard<std::mutex> lock(this->_entries_mutex);
+            auto const it = std::upper_bound(this->_entries.begin(), this->_entries.end(), entry->priority,
+                                             [](uint32_t const priority, auto const &entry) {
+                                                 return priority < entry->priority;
+                                             });
+            this->_entries.insert(it, entry);
+            ++this->_entries_version;
+        }
+
+        this->wake();
+    }
+
+    void remove_entry(identifier const &id) {
+        std::lock_guard<std::mutex> lock(this->_entries_mutex);
+        std::erase_if(this->_entries, [&id](auto const &entry) {
+            if (entry->id == id) {
+                entry->is_removed = true;
+                return true;
+            }
+            return false;
+        });
+        ++this->_entries_version;
+    }
+
+    // copies the entries only if they have changed since the version.
+    void update_entries(std::vector<std::shared_ptr<worker_utils::task_entry>> &entries, std::size_t &version) {
+        if (this->_entries_version == version) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(this->_entries_mutex);
+        entries = this->_entries;
+        version = this->_entries_version;
+    }
+
+    void wake() {
+        this->is_woken = true;
+
+        if (this->is_parked) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->condition.notify_one();
+        }
+    }
+
+    // spins, yields and then parks until woken or the duration elapses.
+    void wait(std::chrono::milliseconds const &duration) {
+        for (std::size_t idx = 0; idx < worker_utils::spin_count; ++idx) {
+            if (this->_is_waiting_finished()) {
+                return;
+            }
+        }
+
+        for (std::size_t idx = 0; idx < worker_utils::yield_count; ++idx) {
+            std::this_thread::yield();
+
+            if (this->_is_waiting_finished()) {
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->is_parked = true;
+        this->condition.wait_for(lock, duration, [this] { return this->_is_waiting_finished(); });
+        this->is_parked = false;
+    }
+
+   private:
+    std::vector<std::shared_ptr<worker_utils::task_entry>> _entries;
+    std::mutex _entries_mutex;
+    std::atomic<std::size_t> _entries_version{1};
+
+    bool _is_waiting_finished() {
+        return !this->is_continue || (this->is_woken && this->is_woken.exchange(false));
+    }
 };
 
 #pragma mark - worker
@@ -62,14 +184,40 @@ worker::~worker() {
 }
 
 void worker::add_task(uint32_t const priority, task_f &&task) {
+    this->insert_task(priority, std::move(task));
+}
+
+identifier worker::insert_task(uint32_t const priority, task_f &&task) {
+    if (!task) {
+        throw std::invalid_argument("worker insert_task() - task is null.");
+    }
+
+    identifier const id;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
     if (this->_resource) {
-        throw std::runtime_error("worker add_task() - already started.");
+        this->_resource->insert_entry(std::make_shared<worker_utils::task_entry>(id, priority, task));
     }
 
-    this->_tasks.emplace(priority, std::move(task));
+    this->_tasks.emplace(priority, std::make_pair(id, std::move(task)));
+
+    return id;
+}
+
+void worker::remove_task(identifier const &id) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::erase_if(this->_tasks, [&id](auto const &pair) { return pair.second.first == id; });
+
+    if (this->_resource) {
+        this->_resource->remove_entry(id);
+    }
 }
 
 void worker::start() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
     if (this->_resource) {
         throw std::runtime_error("worker start() - already started.");
     }
@@ -78,18 +226,48 @@ void worker::start() {
         throw std::runtime_error("worker start() - task is empty.");
     }
 
-    auto tasks = to_vector<task_f>(this->_tasks, [](auto const &pair) { return pair.second; });
+    auto entries = to_vector<std::shared_ptr<worker_utils::task_entry>>(this->_tasks, [](auto const &pair) {
+        return std::make_shared<worker_utils::task_entry>(pair.second.first, pair.first, pair.second.second);
+    });
 
-    this->_resource = std::make_shared<resource>(std::move(tasks));
+    this->_resource = std::make_shared<resource>(std::move(entries));
+
+    std::thread thread{[resource = this->_resource, sleep_duration = this->_sleep_duration, metrics = this->_metrics] {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<std::shared_ptr<worker_utils::task_entry>> entries;
+        std::size_t version = 0;
+        std::vector<identifier> completed_ids;
 
-    std::thread thread{[resource = this->_resource, sleep_duration = this->_sleep_duration] {
         while (resource->is_continue) {
             while (resource->is_continue) {
-                if (!worker_utils::process(resource->tasks)) {
+                resource->update_entries(entries, version);
+
+                auto const begin = metrics ? clock::now() : clock::time_point{};
+
+                bool const processed = worker_utils::process(entries, completed_ids);
+
+                if (metrics) {
+                    metrics->record_busy(processed, clock::now() - begin);
+                }
+
+                for (auto const &id : completed_ids) {
+                    resource->remove_entry(id);
+                }
+                completed_ids.clear();
+
+                if (!processed) {
                     break;
                 }
             }
-            std::this_thread::sleep_for(sleep_duration);
+
+            auto const begin = metrics ? clock::now() : clock::time_point{};
+
+            resource->wait(sleep_duration);
+
+            if (metrics) {
+                metrics->record_idle(clock::now() - begin);
+            }
         }
     }};
 
@@ -97,12 +275,37 @@ void worker::start() {
 }
 
 void worker::stop() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
     if (this->_resource) {
         this->_resource->is_continue = false;
+        this->_resource->wake();
         this->_resource = nullptr;
     }
 }
 
+void worker::wake() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_resource) {
+        this->_resource->wake();
+    }
+}
+
+void worker::set_metrics(worker_metrics_ptr const &metrics) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_resource) {
+        throw std::runtime_error("worker set_metrics() - already started.");
+    }
+
+    this->_metrics = metrics;
+}
+
+worker_metrics_ptr const &worker::metrics() const {
+    return this->_metrics;
+}
+
 worker_ptr worker::make_shared() {
     return worker::make_shared(std::chrono::milliseconds{10});
 }
@@ -145,6 +348,10 @@ void worker_stub::stop() {
     }
 }
 
+void worker_stub::wake() {
+    ++this->_wake_count;
+}
+
 std::vector<workable::task_f> worker_stub::resource_tasks() const {
     return this->_resource->tasks;
 }
@@ -153,6 +360,10 @@ bool worker_stub::is_started() const {
     return this->_resource != nullptr;
 }
 
+std::size_t worker_stub::wake_count() const {
+    return this->_wake_count;
+}
+
 void worker_stub::process() {
     worker_utils::process(this->_resource->tasks);
 }
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <cpp-utils/identifier.h>
+#include <cpp-utils/metrics.h>
+
 #include <chrono>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace yas {
@@ -30,6 +34,9 @@ struct workable {
     virtual void add_task(uint32_t const priority, task_f &&) = 0;
     virtual void start() = 0;
     virtual void stop() = 0;
+    // notifies the worker that new work is available to the tasks. an idle worker processes the tasks at once.
+    // it can be called from any thread, but not concurrently with start() or stop().
+    virtual void wake() = 0;
 
    protected:
     class resource;
@@ -40,17 +47,32 @@ using workable_ptr = std::shared_ptr<workable>;
 struct worker final : workable {
     ~worker();
 
+    // a task can also be added while running.
     void add_task(uint32_t const priority, task_f &&) override;
+    // returns an identifier to remove the task with. it can be called from any thread while running.
+    identifier insert_task(uint32_t const priority, task_f &&);
+    // a removed task is never run again, though it may still be running when this returns. it can be called from any
+    // thread.
+    void remove_task(identifier const &);
     void start() override;
     void stop() override;
+    void wake() override;
+
+    // metrics are not recorded unless they are set before start().
+    void set_metrics(worker_metrics_ptr const &);
+    worker_metrics_ptr const &metrics() const;
 
     static worker_ptr make_shared();
+    // the duration is the longest time to park when idle without being woken.
     static worker_ptr make_shared(std::chrono::milliseconds const &);
 
    private:
-    std::multimap<uint32_t, task_f> _tasks;
+    // guards the tasks and the resource against inserting and removing on other threads.
+    std::mutex _mutex;
+    std::multimap<uint32_t, std::pair<identifier, task_f>> _tasks;
     std::shared_ptr<resource> _resource = nullptr;
     std::chrono::milliseconds _sleep_duration;
+    worker_metrics_ptr _metrics = nullptr;
 
     worker(std::chrono::milliseconds const &);
 };
@@ -59,9 +81,11 @@ struct worker_stub final : workable {
     void add_task(uint32_t const priority, task_f &&) override;
     void start() override;
     void stop() override;
+    void wake() override;
 
     std::vector<task_f> resource_tasks() const;
     bool is_started() const;
+    std::size_t wake_count() const;
     void process();
 
     static worker_stub_ptr make_shared();
@@ -69,6 +93,7 @@ struct worker_stub final : workable {
    private:
     std::multimap<uint32_t, task_f> _tasks;
     std::shared_ptr<resource> _resource = nullptr;
+    std::size_t _wake_count = 0;
 
     worker_stub();
 };
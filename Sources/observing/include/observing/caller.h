@@ -4,21 +4,37 @@
 
 #pragma once
 
-#include <map>
+#include <cpp-utils/ring_deque.h>
+#include <cpp-utils/small_function.h>
+
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 #include "caller_index.hpp"
 #include "canceller.h"
 
+namespace yas::observing::caller_utils {
+template <typename T>
+constexpr bool is_queueable_v = std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>;
+}
+
 namespace yas::observing {
 template <typename T>
 struct caller;
 template <typename T>
 using caller_ptr = std::shared_ptr<caller<T>>;
 
+enum class caller_reentrancy {
+    // a call from a handler while calling is ignored.
+    ignore,
+    // a call from a handler while calling is queued and called after the current call in order. the value is copied.
+    queue,
+};
+
 template <typename T>
 struct caller {
-    using handler_f = std::function<void(T const &)>;
+    using handler_f = small_function<void(T const &)>;
 
     ~caller();
 
@@ -26,23 +42,39 @@ struct caller {
     [[nodiscard]] canceller_ptr add(std::size_t const order, handler_f &&);
     void call(T const &);
 
+    [[nodiscard]] caller_reentrancy reentrancy() const;
+
     static caller_ptr<T> make_shared();
+    // throws if the value is queued but is not default constructible and copy assignable.
+    static caller_ptr<T> make_shared(caller_reentrancy const);
 
    private:
     struct handler_container {
+        caller_index index;
         bool enabled = true;
         handler_f handler;
+        canceller_wptr canceller;
     };
 
     struct member {
-        std::map<caller_index, handler_container> handlers;
-        std::map<uintptr_t, canceller_wptr> cancellers;
+        caller_reentrancy const reentrancy;
+        // sorted by the index. the handlers cancelled while calling are left disabled and removed after the call.
+        std::vector<handler_container> handlers;
+        // the handlers added while calling. they are merged after calling the handlers and called from the next value.
+        std::vector<handler_container> adding;
+        std::size_t disabled_count = 0;
         bool calling = false;
+        std::conditional_t<caller_utils::is_queueable_v<T>, ring_deque<T>, std::monostate> queued;
+
+        member(caller_reentrancy const reentrancy) : reentrancy(reentrancy) {
+        }
     };
 
     std::shared_ptr<member> const _member;
 
-    caller();
+    caller(caller_reentrancy const);
+
+    static void _call_handlers(member &, T const &);
 };
 }  // namespace yas::observing
 
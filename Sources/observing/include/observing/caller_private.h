@@ -4,19 +4,44 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace yas::observing::caller_utils {
+template <typename Container>
+bool less_index(Container const &lhs, Container const &rhs) {
+    return lhs.index < rhs.index;
+}
+
+// compares a container with an index alone, to search the containers without making one.
+template <typename Container>
+struct index_less {
+    bool operator()(Container const &container, caller_index const &index) const {
+        return container.index < index;
+    }
+
+    bool operator()(caller_index const &index, Container const &container) const {
+        return index < container.index;
+    }
+};
+}  // namespace yas::observing::caller_utils
+
 namespace yas::observing {
 template <typename T>
-caller<T>::caller() : _member(std::make_shared<member>()) {
+caller<T>::caller(caller_reentrancy const reentrancy) : _member(std::make_shared<member>(reentrancy)) {
 }
 
 template <typename T>
 caller<T>::~caller() {
     auto const member = this->_member;
-    for (auto const &canceller : member->cancellers) {
-        if (auto shared = canceller.second.lock()) {
+    auto const ignore = [](handler_container const &container) {
+        if (auto shared = container.canceller.lock()) {
             shared->ignore();
         }
-    }
+    };
+    std::for_each(member->handlers.begin(), member->handlers.end(), ignore);
+    std::for_each(member->adding.begin(), member->adding.end(), ignore);
 }
 
 template <typename T>
@@ -30,16 +55,34 @@ canceller_ptr caller<T>::add(std::size_t const order, handler_f &&handler) {
         auto const member = this->_member;
 
         caller_index const index{.identifier = identifier, .order = order};
-        member->handlers.at(index).enabled = false;
-        if (!member->calling) {
-            member->handlers.erase(index);
+
+        // a disabled handler with the same identifier may be left while calling.
+        auto const [first, last] = std::equal_range(member->handlers.begin(), member->handlers.end(), index,
+                                                    caller_utils::index_less<handler_container>{});
+        auto const it = std::find_if(first, last, [](auto const &container) { return container.enabled; });
+
+        if (it != last) {
+            if (member->calling) {
+                it->enabled = false;
+                ++member->disabled_count;
+            } else {
+                member->handlers.erase(it);
+            }
+        } else {
+            std::erase_if(member->adding,
+                          [identifier](auto const &container) { return container.index.identifier == identifier; });
         }
-        member->cancellers.erase(identifier);
     });
-    auto const identifier = canceller->identifier();
-    caller_index const index{.identifier = identifier, .order = order};
-    this->_member->handlers.emplace(index, handler_container{.handler = handler});
-    this->_member->cancellers.emplace(identifier, canceller);
+
+    handler_container container{.index = {.identifier = canceller->identifier(), .order = order},
+                                .handler = std::move(handler),
+                                .canceller = canceller};
+
+    auto &handlers = this->_member->calling ? this->_member->adding : this->_member->handlers;
+    auto const it =
+        std::upper_bound(handlers.begin(), handlers.end(), container, caller_utils::less_index<handler_container>);
+    handlers.emplace(it, std::move(container));
+
     return canceller;
 }
 
@@ -49,25 +92,64 @@ void caller<T>::call(T const &value) {
 
     if (!member->calling) {
         member->calling = true;
-        std::vector<caller_index> removed;
-        for (auto const &pair : member->handlers) {
-            if (pair.second.enabled) {
-                pair.second.handler(value);
-            }
 
-            if (!pair.second.enabled) {
-                removed.emplace_back(pair.first);
+        _call_handlers(*member, value);
+
+        if constexpr (caller_utils::is_queueable_v<T>) {
+            while (!member->queued.empty()) {
+                T const queued = std::move(member->queued.front());
+                member->queued.pop_front();
+                _call_handlers(*member, queued);
             }
         }
-        for (auto const &index : removed) {
-            member->handlers.erase(index);
-        }
+
         member->calling = false;
+    } else if (member->reentrancy == caller_reentrancy::queue) {
+        if constexpr (caller_utils::is_queueable_v<T>) {
+            member->queued.emplace_back(value);
+        }
+    }
+}
+
+template <typename T>
+caller_reentrancy caller<T>::reentrancy() const {
+    return this->_member->reentrancy;
+}
+
+template <typename T>
+void caller<T>::_call_handlers(member &member, T const &value) {
+    // the handlers are not added or removed while calling, so it is a linear scan.
+    for (auto const &container : member.handlers) {
+        if (container.enabled) {
+            container.handler(value);
+        }
+    }
+
+    if (member.disabled_count > 0) {
+        std::erase_if(member.handlers, [](auto const &container) { return !container.enabled; });
+        member.disabled_count = 0;
+    }
+
+    if (!member.adding.empty()) {
+        auto const middle = static_cast<std::ptrdiff_t>(member.handlers.size());
+        std::move(member.adding.begin(), member.adding.end(), std::back_inserter(member.handlers));
+        member.adding.clear();
+        std::inplace_merge(member.handlers.begin(), member.handlers.begin() + middle, member.handlers.end(),
+                           caller_utils::less_index<handler_container>);
     }
 }
 
 template <typename T>
 caller_ptr<T> caller<T>::make_shared() {
-    return caller_ptr<T>(new caller<T>{});
+    return make_shared(caller_reentrancy::ignore);
+}
+
+template <typename T>
+caller_ptr<T> caller<T>::make_shared(caller_reentrancy const reentrancy) {
+    if (reentrancy == caller_reentrancy::queue && !caller_utils::is_queueable_v<T>) {
+        throw std::invalid_argument("caller make_shared() - the value cannot be queued.");
+    }
+
+    return caller_ptr<T>(new caller<T>{reentrancy});
 }
 }  // namespace yas::observing
@@ -0,0 +1,78 @@
+//
+//  concurrent_notifier.h
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "caller.h"
+#include "endable.h"
+
+namespace yas::observing {
+template <typename T>
+class concurrent_notifier;
+
+template <typename T>
+using concurrent_notifier_ptr = std::shared_ptr<concurrent_notifier<T>>;
+
+// a notifier which can be notified, observed and cancelled from any thread. a notification reads a snapshot of the
+// handlers without locking, and observing or cancelling replaces the snapshot. a replaced snapshot is freed when no
+// notification is in progress. a handler may still be called by a notification which has begun before its cancellation.
+template <typename T>
+struct concurrent_notifier final {
+    using handler_f = small_function<void(T const &)>;
+
+    void notify(T const &);
+    void notify();
+
+    [[nodiscard]] endable observe(handler_f &&);
+    [[nodiscard]] endable observe(std::size_t const order, handler_f &&);
+
+    [[nodiscard]] std::size_t handler_count() const;
+
+    [[nodiscard]] static concurrent_notifier_ptr<T> make_shared();
+
+   private:
+    struct handler_container {
+        std::atomic<bool> enabled = true;
+        handler_f handler;
+
+        handler_container(handler_f &&handler) : handler(std::move(handler)) {
+        }
+    };
+
+    struct entry {
+        caller_index index;
+        std::shared_ptr<handler_container> container;
+    };
+
+    struct snapshot {
+        // sorted by the index.
+        std::vector<entry> entries;
+        snapshot *next_retired = nullptr;
+    };
+
+    struct resource {
+        // serializes observing and cancelling. a notification does not take it.
+        std::mutex mutex;
+        std::atomic<snapshot *> current = nullptr;
+        std::atomic<snapshot *> retired = nullptr;
+        std::atomic<std::size_t> reader_count = 0;
+
+        ~resource();
+
+        void add(caller_index const &, handler_f &&);
+        void remove(caller_index const &);
+        void replace(snapshot *);
+        void reclaim();
+    };
+
+    std::shared_ptr<resource> const _resource;
+
+    concurrent_notifier();
+};
+}  // namespace yas::observing
+
+#include "concurrent_notifier_private.h"
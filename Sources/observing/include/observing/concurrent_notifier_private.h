@@ -0,0 +1,190 @@
+//
+//  concurrent_notifier_private.h
+//
+
+#pragma once
+
+#include <algorithm>
+
+namespace yas::observing::concurrent_notifier_utils {
+// counts a notification in progress while it is alive.
+template <typename Resource>
+struct reading final {
+    Resource &resource;
+
+    reading(Resource &resource) : resource(resource) {
+        ++this->resource.reader_count;
+    }
+
+    ~reading() {
+        if (--this->resource.reader_count == 0) {
+            this->resource.reclaim();
+        }
+    }
+};
+}  // namespace yas::observing::concurrent_notifier_utils
+
+namespace yas::observing {
+#pragma mark - resource
+
+template <typename T>
+concurrent_notifier<T>::resource::~resource() {
+    delete this->current.load();
+
+    auto *retired = this->retired.load();
+    while (retired) {
+        auto *const next = retired->next_retired;
+        delete retired;
+        retired = next;
+    }
+}
+
+template <typename T>
+void concurrent_notifier<T>::resource::add(caller_index const &index, handler_f &&handler) {
+    auto container = std::make_shared<handler_container>(std::move(handler));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto *const next = new snapshot{};
+
+    if (auto const *const current = this->current.load()) {
+        next->entries.reserve(current->entries.size() + 1);
+        next->entries = current->entries;
+    }
+
+    auto const it = std::upper_bound(next->entries.begin(), next->entries.end(), index,
+                                     [](caller_index const &index, entry const &entry) { return index < entry.index; });
+    next->entries.insert(it, entry{.index = index, .container = std::move(container)});
+
+    this->replace(next);
+}
+
+template <typename T>
+void concurrent_notifier<T>::resource::remove(caller_index const &index) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto const *const current = this->current.load();
+    if (!current) {
+        return;
+    }
+
+    auto const it = std::find_if(current->entries.begin(), current->entries.end(), [&index](entry const &entry) {
+        return entry.index.identifier == index.identifier && entry.index.order == index.order;
+    });
+    if (it == current->entries.end()) {
+        return;
+    }
+
+    it->container->enabled = false;
+
+    snapshot *next = nullptr;
+
+    if (current->entries.size() > 1) {
+        next = new snapshot{};
+        next->entries.reserve(current->entries.size() - 1);
+        next->entries.insert(next->entries.end(), current->entries.begin(), it);
+        next->entries.insert(next->entries.end(), std::next(it), current->entries.end());
+    }
+
+    this->replace(next);
+}
+
+template <typename T>
+void concurrent_notifier<T>::resource::replace(snapshot *next) {
+    if (auto *const previous = this->current.exchange(next)) {
+        auto *head = this->retired.load();
+        do {
+            previous->next_retired = head;
+        } while (!this->retired.compare_exchange_weak(head, previous));
+    }
+
+    this->reclaim();
+}
+
+template <typename T>
+void concurrent_notifier<T>::resource::reclaim() {
+    auto *retired = this->retired.exchange(nullptr);
+    if (!retired) {
+        return;
+    }
+
+    // the snapshots were replaced before the count is read. a notification reading them has been counted until its end.
+    if (this->reader_count == 0) {
+        while (retired) {
+            auto *const next = retired->next_retired;
+            delete retired;
+            retired = next;
+        }
+    } else {
+        auto *tail = retired;
+        while (tail->next_retired) {
+            tail = tail->next_retired;
+        }
+
+        auto *head = this->retired.load();
+        do {
+            tail->next_retired = head;
+        } while (!this->retired.compare_exchange_weak(head, retired));
+    }
+}
+
+#pragma mark - concurrent_notifier
+
+template <typename T>
+concurrent_notifier<T>::concurrent_notifier() : _resource(std::make_shared<resource>()) {
+}
+
+template <typename T>
+void concurrent_notifier<T>::notify(T const &value) {
+    auto const resource = this->_resource;
+    concurrent_notifier_utils::reading const reading{*resource};
+
+    if (auto const *const snapshot = resource->current.load()) {
+        for (auto const &entry : snapshot->entries) {
+            if (entry.container->enabled.load(std::memory_order_relaxed)) {
+                entry.container->handler(value);
+            }
+        }
+    }
+}
+
+template <typename T>
+void concurrent_notifier<T>::notify() {
+    this->notify(nullptr);
+}
+
+template <typename T>
+endable concurrent_notifier<T>::observe(handler_f &&handler) {
+    return this->observe(0, std::move(handler));
+}
+
+template <typename T>
+endable concurrent_notifier<T>::observe(std::size_t const order, handler_f &&handler) {
+    return endable{[shared_resource = this->_resource, order, handler = std::move(handler)]() mutable {
+        std::weak_ptr<resource> const weak_resource = shared_resource;
+
+        auto canceller = canceller::make_shared([weak_resource, order](uintptr_t const identifier) {
+            if (auto const resource = weak_resource.lock()) {
+                resource->remove({.identifier = identifier, .order = order});
+            }
+        });
+
+        shared_resource->add({.identifier = canceller->identifier(), .order = order}, std::move(handler));
+
+        return canceller;
+    }};
+}
+
+template <typename T>
+std::size_t concurrent_notifier<T>::handler_count() const {
+    std::lock_guard<std::mutex> lock(this->_resource->mutex);
+
+    auto const *const current = this->_resource->current.load();
+    return current ? current->entries.size() : 0;
+}
+
+template <typename T>
+concurrent_notifier_ptr<T> concurrent_notifier<T>::make_shared() {
+    return concurrent_notifier_ptr<T>(new concurrent_notifier<T>{});
+}
+}  // namespace yas::observing
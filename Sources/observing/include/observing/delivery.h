@@ -0,0 +1,81 @@
+//
+//  delivery.h
+//
+
+#pragma once
+
+#include <cpp-utils/executor.h>
+#include <cpp-utils/small_function.h>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace yas::observing {
+template <typename T>
+class delivery;
+
+template <typename T>
+using delivery_ptr = std::shared_ptr<delivery<T>>;
+
+// delivers the values pushed from any thread to a handler on an executor. the values pushed while a delivery is pending
+// or running are coalesced into the latest one, so the handler is called one at a time with the latest value. an
+// exception thrown by the handler does not leave the executor, and the later values are still delivered.
+template <typename T>
+struct delivery final {
+    using handler_f = small_function<void(T const &)>;
+    // called on the executor with the exception thrown by the handler.
+    using error_handler_f = small_function<void(std::exception_ptr const &)>;
+
+    void push(T const &);
+    // changes the pending value in place under the lock, so that a large value is not copied on each change. the
+    // function takes a std::optional<T> &, which is empty once the pending value has been taken to deliver.
+    template <typename F>
+    void update(F &&);
+    // the pushed values are not delivered after it. a delivery which has already begun is completed.
+    void cancel();
+    [[nodiscard]] bool is_cancelled() const;
+
+    [[nodiscard]] static delivery_ptr<T> make_shared(executable_ptr const &, handler_f &&);
+    [[nodiscard]] static delivery_ptr<T> make_shared(executable_ptr const &, handler_f &&, error_handler_f &&);
+
+   private:
+    executable_ptr const _executor;
+    handler_f const _handler;
+    error_handler_f const _error_handler;
+    std::weak_ptr<delivery> _weak_delivery;
+    std::atomic<bool> _is_cancelled = false;
+
+    std::mutex _mutex;
+    // the value is moved out to deliver, so a delivered value is not kept alive after its delivery.
+    std::optional<T> _pending = std::nullopt;
+    bool _has_pending = false;
+    bool _is_scheduled = false;
+
+    delivery(executable_ptr const &, handler_f &&, error_handler_f &&);
+
+    void _schedule();
+    void _deliver();
+};
+}  // namespace yas::observing
+
+namespace yas::observing::delivery_utils {
+// cancels the delivery when it is destroyed with the handler of a caller.
+template <typename T>
+struct subscription final {
+    delivery_ptr<T> delivery;
+
+    subscription(delivery_ptr<T> const &);
+    ~subscription();
+
+    subscription(subscription &&) noexcept = default;
+
+    subscription(subscription const &) = delete;
+    subscription &operator=(subscription const &) = delete;
+    subscription &operator=(subscription &&) = delete;
+};
+}  // namespace yas::observing::delivery_utils
+
+#include "delivery_private.h"
@@ -0,0 +1,122 @@
+//
+//  delivery_private.h
+//
+
+#pragma once
+
+#include <stdexcept>
+
+namespace yas::observing {
+template <typename T>
+delivery<T>::delivery(executable_ptr const &executor, handler_f &&handler, error_handler_f &&error_handler)
+    : _executor(executor), _handler(std::move(handler)), _error_handler(std::move(error_handler)) {
+}
+
+template <typename T>
+void delivery<T>::push(T const &value) {
+    this->update([&value](std::optional<T> &pending) { pending = value; });
+}
+
+template <typename T>
+template <typename F>
+void delivery<T>::update(F &&function) {
+    if (this->_is_cancelled) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        function(this->_pending);
+        this->_has_pending = true;
+
+        if (this->_is_scheduled) {
+            return;
+        }
+
+        this->_is_scheduled = true;
+    }
+
+    this->_schedule();
+}
+
+template <typename T>
+void delivery<T>::cancel() {
+    this->_is_cancelled = true;
+}
+
+template <typename T>
+bool delivery<T>::is_cancelled() const {
+    return this->_is_cancelled;
+}
+
+template <typename T>
+void delivery<T>::_schedule() {
+    this->_executor->execute([delivery = this->_weak_delivery.lock()] { delivery->_deliver(); });
+}
+
+template <typename T>
+void delivery<T>::_deliver() {
+    std::optional<T> delivering = std::nullopt;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        delivering.swap(this->_pending);
+        this->_has_pending = false;
+    }
+
+    if (!this->_is_cancelled) {
+        try {
+            this->_handler(*delivering);
+        } catch (...) {
+            // the executor may not catch it, so it is reported here and the later values are still delivered.
+            if (this->_error_handler) {
+                this->_error_handler(std::current_exception());
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        // the values pushed while delivering are delivered next.
+        if (!this->_has_pending || this->_is_cancelled) {
+            this->_is_scheduled = false;
+            return;
+        }
+    }
+
+    this->_schedule();
+}
+
+template <typename T>
+delivery_ptr<T> delivery<T>::make_shared(executable_ptr const &executor, handler_f &&handler) {
+    return make_shared(executor, std::move(handler), nullptr);
+}
+
+template <typename T>
+delivery_ptr<T> delivery<T>::make_shared(executable_ptr const &executor, handler_f &&handler,
+                                         error_handler_f &&error_handler) {
+    if (!executor) {
+        throw std::invalid_argument("delivery make_shared() - executor is null.");
+    }
+
+    auto shared = delivery_ptr<T>(new delivery<T>{executor, std::move(handler), std::move(error_handler)});
+    shared->_weak_delivery = shared;
+    return shared;
+}
+}  // namespace yas::observing
+
+namespace yas::observing::delivery_utils {
+template <typename T>
+subscription<T>::subscription(delivery_ptr<T> const &delivery) : delivery(delivery) {
+}
+
+template <typename T>
+subscription<T>::~subscription() {
+    if (this->delivery) {
+        this->delivery->cancel();
+    }
+}
+}  // namespace yas::observing::delivery_utils
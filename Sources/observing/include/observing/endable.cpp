@@ -14,7 +14,7 @@ using namespace yas::observing;
 endable::endable() {
 }
 
-endable::endable(std::function<canceller_ptr(void)> &&handler) {
+endable::endable(handler_f &&handler) {
     if (handler) {
         this->_handlers.emplace_back(std::move(handler));
     }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cpp-utils/small_function.h>
+
 #include <vector>
 
 #include "canceller.h"
@@ -12,8 +14,10 @@ namespace yas::observing {
 class syncable;
 
 struct endable final {
+    using handler_f = small_function<canceller_ptr(void)>;
+
     endable();
-    explicit endable(std::function<canceller_ptr(void)> &&);
+    explicit endable(handler_f &&);
 
     endable(endable &&) = default;
     endable &operator=(endable &&) = default;
@@ -23,7 +27,7 @@ struct endable final {
     void merge(endable &&);
 
    private:
-    std::vector<std::function<canceller_ptr(void)>> _handlers;
+    std::vector<handler_f> _handlers;
 
     endable(endable const &) = delete;
     endable &operator=(endable const &) = delete;
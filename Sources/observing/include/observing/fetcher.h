@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include "caller.h"
 #include "syncable.h"
 
 namespace yas::observing {
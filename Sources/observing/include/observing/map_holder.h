@@ -5,7 +5,10 @@
 #pragma once
 
 #include <map>
+#include <optional>
 
+#include "caller.h"
+#include "delivery.h"
 #include "syncable.h"
 
 namespace yas::observing::map {
@@ -45,6 +48,9 @@ struct holder final {
 
     [[nodiscard]] syncable observe(typename caller<event>::handler_f &&);
     [[nodiscard]] syncable observe(std::size_t const order, typename caller<event>::handler_f &&);
+    // the handler is called on the executor with a copy of the latest elements changed since its last call.
+    [[nodiscard]] syncable observe_on(executable_ptr const &,
+                                      typename delivery<std::map<Key, Element>>::handler_f &&);
 
     [[nodiscard]] static holder_ptr<Key, Element> make_shared();
     [[nodiscard]] static holder_ptr<Key, Element> make_shared(std::map<Key, Element> &&);
@@ -105,6 +105,38 @@ syncable holder<Key, Element>::observe(std::size_t const order, typename caller<
     }};
 }
 
+template <typename Key, typename Element>
+syncable holder<Key, Element>::observe_on(executable_ptr const &executor,
+                                          typename delivery<std::map<Key, Element>>::handler_f &&handler) {
+    delivery_utils::subscription<std::map<Key, Element>> subscription{
+        delivery<std::map<Key, Element>>::make_shared(executor, std::move(handler))};
+
+    // the change is applied to the pending elements, so that the whole elements are copied once for each delivery.
+    return this->observe([subscription = std::move(subscription)](auto const &event) {
+        subscription.delivery->update([&event](std::optional<std::map<Key, Element>> &pending) {
+            if (!pending.has_value() || event.type == event_type::any) {
+                pending = event.elements;
+                return;
+            }
+
+            auto &elements = pending.value();
+            auto const &key = event.key.value();
+
+            switch (event.type) {
+                case event_type::replaced:
+                case event_type::inserted:
+                    elements.insert_or_assign(key, *event.inserted);
+                    break;
+                case event_type::erased:
+                    elements.erase(key);
+                    break;
+                case event_type::any:
+                    break;
+            }
+        });
+    });
+}
+
 template <typename Key, typename Element>
 holder_ptr<Key, Element> holder<Key, Element>::make_shared() {
     return make_shared({});
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "caller.h"
+#include "delivery.h"
 #include "syncable.h"
 
 namespace yas::observing {
@@ -20,13 +22,18 @@ struct notifier final {
 
     [[nodiscard]] endable observe(typename caller<T>::handler_f &&);
     [[nodiscard]] endable observe(std::size_t const order, typename caller<T>::handler_f &&);
+    // the handler is called on the executor with the latest of the values notified since its last call.
+    [[nodiscard]] endable observe_on(executable_ptr const &, typename delivery<T>::handler_f &&);
 
     [[nodiscard]] static notifier_ptr<T> make_shared();
+    // queues the notifications from the observers while notifying. throws if the value cannot be queued.
+    [[nodiscard]] static notifier_ptr<T> make_shared(caller_reentrancy const);
 
    private:
+    caller_reentrancy const _reentrancy;
     caller_ptr<T> _caller = nullptr;
 
-    notifier();
+    notifier(caller_reentrancy const);
 };
 }  // namespace yas::observing
 
@@ -6,7 +6,7 @@
 
 namespace yas::observing {
 template <typename T>
-notifier<T>::notifier() {
+notifier<T>::notifier(caller_reentrancy const reentrancy) : _reentrancy(reentrancy) {
 }
 
 template <typename T>
@@ -31,7 +31,7 @@ endable notifier<T>::observe(typename caller<T>::handler_f &&handler) {
 template <typename T>
 endable notifier<T>::observe(std::size_t const order, typename caller<T>::handler_f &&handler) {
     if (!this->_caller) {
-        this->_caller = caller<T>::make_shared();
+        this->_caller = caller<T>::make_shared(this->_reentrancy);
     }
 
     return endable{[this, order, handler = std::move(handler)]() mutable {
@@ -39,8 +39,25 @@ endable notifier<T>::observe(std::size_t const order, typename caller<T>::handle
     }};
 }
 
+template <typename T>
+endable notifier<T>::observe_on(executable_ptr const &executor, typename delivery<T>::handler_f &&handler) {
+    delivery_utils::subscription<T> subscription{delivery<T>::make_shared(executor, std::move(handler))};
+
+    return this->observe(
+        [subscription = std::move(subscription)](T const &value) { subscription.delivery->push(value); });
+}
+
 template <typename T>
 notifier_ptr<T> notifier<T>::make_shared() {
-    return std::shared_ptr<notifier<T>>(new notifier<T>{});
+    return make_shared(caller_reentrancy::ignore);
+}
+
+template <typename T>
+notifier_ptr<T> notifier<T>::make_shared(caller_reentrancy const reentrancy) {
+    if (reentrancy == caller_reentrancy::queue && !caller_utils::is_queueable_v<T>) {
+        throw std::invalid_argument("notifier make_shared() - the value cannot be queued.");
+    }
+
+    return std::shared_ptr<notifier<T>>(new notifier<T>{reentrancy});
 }
 }  // namespace yas::observing
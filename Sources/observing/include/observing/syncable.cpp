@@ -14,7 +14,7 @@ using namespace yas::observing;
 syncable::syncable() {
 }
 
-syncable::syncable(std::function<canceller_ptr(bool const)> &&handler) {
+syncable::syncable(handler_f &&handler) {
     if (handler) {
         this->_sync_handlers.emplace_back(std::move(handler));
     }
@@ -44,8 +44,8 @@ endable syncable::to_endable() {
     endable result;
 
     if (this->_sync_handlers.size() > 0) {
-        for (auto const &handler : this->_sync_handlers) {
-            result._handlers.emplace_back([handler] { return handler(false); });
+        for (auto &handler : this->_sync_handlers) {
+            result._handlers.emplace_back([handler = std::move(handler)] { return handler(false); });
         }
         this->_sync_handlers.clear();
     }
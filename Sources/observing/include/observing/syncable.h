@@ -8,8 +8,10 @@
 
 namespace yas::observing {
 struct syncable final {
+    using handler_f = small_function<canceller_ptr(bool const)>;
+
     syncable();
-    explicit syncable(std::function<canceller_ptr(bool const)> &&);
+    explicit syncable(handler_f &&);
 
     syncable(syncable &&) = default;
     syncable &operator=(syncable &&) = default;
@@ -23,8 +25,8 @@ struct syncable final {
     endable to_endable();
 
    private:
-    std::vector<std::function<canceller_ptr(bool const)>> _sync_handlers;
-    std::vector<std::function<canceller_ptr(void)>> _end_handlers;
+    std::vector<handler_f> _sync_handlers;
+    std::vector<endable::handler_f> _end_handlers;
 
     cancellable_ptr _call_handlers(bool const);
 
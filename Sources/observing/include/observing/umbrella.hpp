@@ -7,6 +7,8 @@
 #include "caller.h"
 #include "canceller.h"
 #include "canceller_pool.h"
+#include "concurrent_notifier.h"
+#include "delivery.h"
 #include "fetcher.h"
 #include "map_holder.h"
 #include "notifier.h"
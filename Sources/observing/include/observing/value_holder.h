@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "caller.h"
+#include "delivery.h"
 #include "syncable.h"
 
 namespace yas::observing::value {
@@ -22,6 +24,8 @@ struct holder final {
 
     [[nodiscard]] syncable observe(typename caller<T>::handler_f &&);
     [[nodiscard]] syncable observe(std::size_t const order, typename caller<T>::handler_f &&);
+    // the handler is called on the executor with the latest of the values set since its last call.
+    [[nodiscard]] syncable observe_on(executable_ptr const &, typename delivery<T>::handler_f &&);
 
     [[nodiscard]] static holder_ptr<T> make_shared(T const &);
     [[nodiscard]] static holder_ptr<T> make_shared(T &&);
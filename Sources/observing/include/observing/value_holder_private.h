@@ -51,6 +51,14 @@ syncable holder<T>::observe(std::size_t const order, typename caller<T>::handler
     }};
 }
 
+template <typename T>
+syncable holder<T>::observe_on(executable_ptr const &executor, typename delivery<T>::handler_f &&handler) {
+    delivery_utils::subscription<T> subscription{delivery<T>::make_shared(executor, std::move(handler))};
+
+    return this->observe(
+        [subscription = std::move(subscription)](T const &value) { subscription.delivery->push(value); });
+}
+
 template <typename T>
 [[nodiscard]] holder_ptr<T> holder<T>::make_shared(T const &value) {
     T copied = value;
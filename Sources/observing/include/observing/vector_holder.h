@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
+#include "caller.h"
+#include "delivery.h"
 #include "syncable.h"
 
 namespace yas::observing::vector {
@@ -50,6 +53,8 @@ struct holder final {
 
     [[nodiscard]] syncable observe(typename caller<event>::handler_f &&);
     [[nodiscard]] syncable observe(std::size_t const order, typename caller<event>::handler_f &&);
+    // the handler is called on the executor with a copy of the latest elements changed since its last call.
+    [[nodiscard]] syncable observe_on(executable_ptr const &, typename delivery<std::vector<T>>::handler_f &&);
 
     [[nodiscard]] static holder_ptr<T> make_shared();
     [[nodiscard]] static holder_ptr<T> make_shared(std::vector<T> &&);
@@ -124,6 +124,40 @@ syncable holder<T>::observe(std::size_t const order, typename caller<event>::han
     }};
 }
 
+template <typename T>
+syncable holder<T>::observe_on(executable_ptr const &executor,
+                               typename delivery<std::vector<T>>::handler_f &&handler) {
+    delivery_utils::subscription<std::vector<T>> subscription{
+        delivery<std::vector<T>>::make_shared(executor, std::move(handler))};
+
+    // the change is applied to the pending elements, so that the whole elements are copied once for each delivery.
+    return this->observe([subscription = std::move(subscription)](auto const &event) {
+        subscription.delivery->update([&event](std::optional<std::vector<T>> &pending) {
+            if (!pending.has_value() || event.type == event_type::any) {
+                pending = event.elements;
+                return;
+            }
+
+            auto &elements = pending.value();
+            auto const idx = event.index.value();
+
+            switch (event.type) {
+                case event_type::replaced:
+                    elements.at(idx) = *event.inserted;
+                    break;
+                case event_type::inserted:
+                    elements.insert(elements.begin() + idx, *event.inserted);
+                    break;
+                case event_type::erased:
+                    elements.erase(elements.begin() + idx);
+                    break;
+                case event_type::any:
+                    break;
+            }
+        });
+    });
+}
+
 template <typename T>
 void holder<T>::_call_any() {
     if (auto const &caller = this->_caller) {
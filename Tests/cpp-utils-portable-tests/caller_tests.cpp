@@ -0,0 +1,316 @@
+//
+//  caller_tests.cpp
+//
+
+#include <observing/umbrella.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "test.h"
+
+using namespace yas;
+using namespace yas::observing;
+
+YAS_TEST(caller, call) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto canceller1 = caller->add([&called1](int const &value) { called1.emplace_back(value); });
+    auto canceller2 = caller->add([&called2](int const &value) { called2.emplace_back(value); });
+
+    caller->call(1);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1}));
+
+    canceller1->cancel();
+
+    caller->call(2);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1, 2}));
+}
+
+YAS_TEST(caller, call_with_order) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<std::size_t> called;
+    observing::canceller_pool pool;
+
+    caller->add(2, [&called](int const &) { called.emplace_back(2); })->add_to(pool);
+    caller->add(1, [&called](int const &) { called.emplace_back(1); })->add_to(pool);
+    caller->add(0, [&called](int const &) { called.emplace_back(0); })->add_to(pool);
+
+    caller->call(1);
+
+    YAS_TEST_ASSERT((called == std::vector<std::size_t>{0, 1, 2}));
+
+    pool.cancel();
+}
+
+YAS_TEST(caller, ignore) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+
+    auto canceller = caller->add([&called](int const &value) { called.emplace_back(value); });
+
+    caller->call(3);
+    canceller->ignore();
+    caller->call(4);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{3, 4}));
+}
+
+YAS_TEST(caller, destruct_caller) {
+    std::vector<int> called;
+
+    canceller_ptr canceller = nullptr;
+
+    {
+        auto caller = observing::caller<int>::make_shared();
+
+        canceller = caller->add([&called](int const &value) { called.emplace_back(value); });
+
+        caller->call(5);
+    }
+
+    YAS_TEST_ASSERT((called == std::vector<int>{5}));
+}
+
+YAS_TEST(caller, destruct_canceller) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+
+    {
+        auto canceller = caller->add([&called](int const &value) { called.emplace_back(value); });
+
+        caller->call(6);
+    }
+
+    caller->call(7);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{6}));
+}
+
+YAS_TEST(caller, ignore_recursive_call) {
+    auto caller = observing::caller<int>::make_shared();
+
+    int called_count = 0;
+
+    auto canceller = caller->add([&caller, &called_count](int const &value) {
+        ++called_count;
+        caller->call(value);
+    });
+
+    caller->call(0);
+
+    YAS_TEST_ASSERT_EQUAL(called_count, 1);
+}
+
+YAS_TEST(caller, destruct_on_calling) {
+    struct caller_holder {
+        observing::caller_ptr<int> caller = observing::caller<int>::make_shared();
+    };
+
+    auto holder = std::make_shared<caller_holder>();
+
+    auto canceller = holder->caller->add([&holder](int const &) { holder->caller = nullptr; });
+
+    holder->caller->call(0);
+
+    canceller->cancel();
+}
+
+YAS_TEST(caller, cancel_on_calling) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    canceller_ptr canceller2 = nullptr;
+
+    auto canceller1 = caller->add(0, [&called, &canceller2](int const &value) {
+        called.emplace_back(value);
+        canceller2->cancel();
+    });
+    canceller2 = caller->add(1, [&called](int const &value) { called.emplace_back(value + 100); });
+    auto canceller3 = caller->add(2, [&called](int const &value) { called.emplace_back(value + 200); });
+
+    caller->call(1);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 201}));
+
+    canceller1->cancel();
+
+    caller->call(2);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 201, 202}));
+}
+
+YAS_TEST(caller, add_on_calling) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    std::vector<canceller_ptr> cancellers;
+
+    cancellers.emplace_back(caller->add(1, [&caller, &called, &cancellers](int const &value) {
+        called.emplace_back(value);
+
+        if (cancellers.size() == 1) {
+            cancellers.emplace_back(caller->add(0, [&called](int const &value) { called.emplace_back(value + 100); }));
+            cancellers.emplace_back(caller->add(2, [&called](int const &value) { called.emplace_back(value + 200); }));
+        }
+    }));
+
+    caller->call(1);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+
+    caller->call(2);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 102, 2, 202}));
+
+    cancellers.at(2)->cancel();
+
+    caller->call(3);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 102, 2, 202, 103, 3}));
+}
+
+YAS_TEST(caller, cancel_added_on_calling) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    canceller_ptr added = nullptr;
+
+    auto canceller = caller->add([&caller, &called, &added](int const &value) {
+        called.emplace_back(value);
+
+        if (!added) {
+            added = caller->add([&called](int const &value) { called.emplace_back(value + 100); });
+            added->cancel();
+        }
+    });
+
+    caller->call(1);
+    caller->call(2);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2}));
+}
+
+YAS_TEST(caller, many_handlers) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::size_t const count = 10000;
+    std::vector<std::size_t> called;
+    std::vector<canceller_ptr> cancellers;
+
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        std::size_t const order = count - 1 - idx;
+        cancellers.emplace_back(caller->add(order, [&called, order](int const &) { called.emplace_back(order); }));
+    }
+
+    for (std::size_t idx = 0; idx < count; idx += 2) {
+        cancellers.at(idx)->cancel();
+    }
+
+    caller->call(0);
+
+    YAS_TEST_ASSERT_EQUAL(called.size(), count / 2);
+    YAS_TEST_ASSERT(std::is_sorted(called.begin(), called.end()));
+    YAS_TEST_ASSERT_EQUAL(called.front(), 0);
+}
+
+YAS_TEST(caller, move_only_handler) {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    auto offset = std::make_unique<int>(10);
+
+    auto canceller = caller->add(
+        [&called, offset = std::move(offset)](int const &value) { called.emplace_back(value + *offset); });
+
+    caller->call(1);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{11}));
+}
+
+YAS_TEST(caller, queue_recursive_call) {
+    auto caller = observing::caller<int>::make_shared(caller_reentrancy::queue);
+
+    YAS_TEST_ASSERT(caller->reentrancy() == caller_reentrancy::queue);
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto canceller1 = caller->add(0, [&caller, &called1](int const &value) {
+        called1.emplace_back(value);
+
+        if (value == 0) {
+            caller->call(1);
+            caller->call(2);
+        }
+    });
+    auto canceller2 = caller->add(1, [&called2](int const &value) { called2.emplace_back(value); });
+
+    caller->call(0);
+
+    // the queued values are called after all of the handlers are called with the current value.
+    YAS_TEST_ASSERT((called1 == std::vector<int>{0, 1, 2}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{0, 1, 2}));
+}
+
+YAS_TEST(caller, queue_cascading_call) {
+    auto caller = observing::caller<int>::make_shared(caller_reentrancy::queue);
+
+    std::vector<int> called;
+
+    auto canceller = caller->add([&caller, &called](int const &value) {
+        called.emplace_back(value);
+
+        if (value < 3) {
+            caller->call(value + 1);
+        }
+    });
+
+    caller->call(0);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2, 3}));
+
+    caller->call(10);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2, 3, 10}));
+}
+
+YAS_TEST(caller, queue_with_added_on_calling) {
+    auto caller = observing::caller<int>::make_shared(caller_reentrancy::queue);
+
+    std::vector<int> called;
+    canceller_ptr added = nullptr;
+
+    auto canceller = caller->add(1, [&caller, &called, &added](int const &value) {
+        called.emplace_back(value);
+
+        if (value == 0) {
+            added = caller->add(0, [&called](int const &value) { called.emplace_back(value + 100); });
+            caller->call(1);
+        }
+    });
+
+    caller->call(0);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 101, 1}));
+}
+
+YAS_TEST(caller, make_shared_not_queueable) {
+    struct referencing {
+        int const &value;
+    };
+
+    YAS_TEST_ASSERT(observing::caller<referencing>::make_shared()->reentrancy() == caller_reentrancy::ignore);
+    YAS_TEST_ASSERT_THROWS(observing::caller<referencing>::make_shared(caller_reentrancy::queue));
+}
@@ -0,0 +1,143 @@
+//
+//  concurrent_notifier_tests.cpp
+//
+
+#include <observing/umbrella.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace yas;
+using namespace yas::observing;
+
+YAS_TEST(concurrent_notifier, notify) {
+    auto const notifier = concurrent_notifier<int>::make_shared();
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto const canceller1 = notifier->observe([&called1](int const &value) { called1.emplace_back(value); }).end();
+    auto const canceller2 = notifier->observe([&called2](int const &value) { called2.emplace_back(value); }).end();
+
+    YAS_TEST_ASSERT_EQUAL(notifier->handler_count(), 2);
+
+    notifier->notify(1);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1}));
+
+    canceller1->cancel();
+
+    YAS_TEST_ASSERT_EQUAL(notifier->handler_count(), 1);
+
+    notifier->notify(2);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1, 2}));
+}
+
+YAS_TEST(concurrent_notifier, observe_with_order) {
+    auto const notifier = concurrent_notifier<std::nullptr_t>::make_shared();
+
+    std::vector<int> called;
+
+    auto const canceller1 = notifier->observe(1, [&called](auto const &) { called.emplace_back(1); }).end();
+    auto const canceller2 = notifier->observe(0, [&called](auto const &) { called.emplace_back(0); }).end();
+
+    notifier->notify();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1}));
+}
+
+YAS_TEST(concurrent_notifier, cancel_and_observe_on_notifying) {
+    auto const notifier = concurrent_notifier<int>::make_shared();
+
+    std::vector<int> called;
+    cancellable_ptr canceller2 = nullptr;
+    cancellable_ptr added = nullptr;
+
+    auto const canceller1 = notifier
+                                ->observe(0,
+                                          [&notifier, &called, &canceller2, &added](int const &value) {
+                                              called.emplace_back(value);
+
+                                              if (!added) {
+                                                  canceller2->cancel();
+                                                  added = notifier
+                                                              ->observe(2,
+                                                                        [&called](int const &value) {
+                                                                            called.emplace_back(value + 200);
+                                                                        })
+                                                              .end();
+                                              }
+                                          })
+                                .end();
+    canceller2 = notifier->observe(1, [&called](int const &value) { called.emplace_back(value + 100); }).end();
+
+    notifier->notify(1);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+
+    notifier->notify(2);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 202}));
+}
+
+YAS_TEST(concurrent_notifier, destruct_notifier) {
+    std::vector<int> called;
+    cancellable_ptr canceller = nullptr;
+
+    {
+        auto const notifier = concurrent_notifier<int>::make_shared();
+        canceller = notifier->observe([&called](int const &value) { called.emplace_back(value); }).end();
+        notifier->notify(1);
+    }
+
+    canceller->cancel();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+}
+
+YAS_TEST(concurrent_notifier, notify_from_threads) {
+    auto const notifier = concurrent_notifier<int>::make_shared();
+
+    std::size_t const notifying_count = 4;
+    std::size_t const notification_count = 10000;
+    std::atomic<std::size_t> stable_count = 0;
+    std::atomic<std::size_t> observing_count = 0;
+    std::atomic<bool> is_notifying = true;
+
+    auto const stable = notifier->observe([&stable_count](int const &) { ++stable_count; }).end();
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t idx = 0; idx < notifying_count; ++idx) {
+        threads.emplace_back([&notifier] {
+            for (std::size_t idx = 0; idx < notification_count; ++idx) {
+                notifier->notify(static_cast<int>(idx));
+            }
+        });
+    }
+
+    // observes and cancels while notifying.
+    std::thread observing_thread{[&notifier, &observing_count, &is_notifying] {
+        while (is_notifying) {
+            auto canceller = notifier->observe([&observing_count](int const &) { ++observing_count; }).end();
+            std::this_thread::yield();
+            canceller->cancel();
+        }
+    }};
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    is_notifying = false;
+    observing_thread.join();
+
+    YAS_TEST_ASSERT_EQUAL(stable_count.load(), notifying_count * notification_count);
+    YAS_TEST_ASSERT_EQUAL(notifier->handler_count(), 1);
+}
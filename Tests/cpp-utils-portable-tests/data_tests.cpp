@@ -0,0 +1,71 @@
+//
+//  data_tests.cpp
+//
+
+#include <cpp-utils/data.h>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(data, execute_with_stride_float) {
+    std::vector<float> src_vec{2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f};
+    std::vector<float> dst_vec(12, 0.0f);
+
+    data_copy<float> data_copy{.src_data = make_const_data(src_vec, 2),
+                               .dst_data = make_data(dst_vec, 3),
+                               .src_begin_idx = 1,
+                               .dst_begin_idx = 2,
+                               .length = 2};
+
+    YAS_TEST_ASSERT(data_copy.execute().is_success());
+    YAS_TEST_ASSERT((dst_vec == std::vector<float>{0, 0, 0, 0, 0, 0, 8.0f, 0, 0, 32.0f, 0, 0}));
+}
+
+YAS_TEST(data, execute_with_stride_double) {
+    std::vector<double> src_vec{4.0, 2.0, 1.0, 0.5, 0.25, 0.125};
+    std::vector<double> dst_vec(12, 0.0);
+
+    data_copy<double> data_copy{.src_data = make_const_data(src_vec, 2),
+                                .dst_data = make_data(dst_vec, 3),
+                                .src_begin_idx = 1,
+                                .dst_begin_idx = 2,
+                                .length = 2};
+
+    YAS_TEST_ASSERT(data_copy.execute().is_success());
+    YAS_TEST_ASSERT((dst_vec == std::vector<double>{0, 0, 0, 0, 0, 0, 1.0, 0, 0, 0.25, 0, 0}));
+}
+
+YAS_TEST(data, execute_cyclical_with_stride_float) {
+    std::vector<float> src_vec{2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f};
+    std::vector<float> dst_vec(12, 0.0f);
+
+    data_copy<float> data_copy{.src_data = make_const_data(src_vec, 2),
+                               .dst_data = make_data(dst_vec, 3),
+                               .src_begin_idx = 1,
+                               .dst_begin_idx = 3,
+                               .length = 2};
+
+    auto const result = data_copy.execute_cyclical();
+
+    YAS_TEST_ASSERT(result.is_success());
+    YAS_TEST_ASSERT_EQUAL(result.value(), 1);
+    YAS_TEST_ASSERT((dst_vec == std::vector<float>{32.0f, 0, 0, 0, 0, 0, 0, 0, 0, 8.0f, 0, 0}));
+}
+
+YAS_TEST(data, execute_cyclical_with_stride_double) {
+    std::vector<double> src_vec{4.0, 2.0, 1.0, 0.5, 0.25, 0.125};
+    std::vector<double> dst_vec(12, 0.0);
+
+    data_copy<double> data_copy{.src_data = make_const_data(src_vec, 2),
+                                .dst_data = make_data(dst_vec, 3),
+                                .src_begin_idx = 1,
+                                .dst_begin_idx = 3,
+                                .length = 2};
+
+    auto const result = data_copy.execute_cyclical();
+
+    YAS_TEST_ASSERT(result.is_success());
+    YAS_TEST_ASSERT_EQUAL(result.value(), 1);
+    YAS_TEST_ASSERT((dst_vec == std::vector<double>{0.25, 0, 0, 0, 0, 0, 0, 0, 0, 1.0, 0, 0}));
+}
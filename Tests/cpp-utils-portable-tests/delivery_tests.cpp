@@ -0,0 +1,347 @@
+//
+//  delivery_tests.cpp
+//
+
+#include <cpp-utils/executor.h>
+#include <observing/umbrella.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace yas;
+using namespace yas::observing;
+
+YAS_TEST(delivery, coalesce) {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+
+    auto const delivery = observing::delivery<int>::make_shared(
+        executor, [&called](int const &value) { called.emplace_back(value); });
+
+    delivery->push(1);
+    delivery->push(2);
+    delivery->push(3);
+
+    YAS_TEST_ASSERT(called.empty());
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{3}));
+
+    delivery->push(4);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{3, 4}));
+}
+
+YAS_TEST(delivery, push_while_delivering) {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+    delivery_ptr<int> delivery = nullptr;
+
+    delivery = observing::delivery<int>::make_shared(executor, [&called, &delivery](int const &value) {
+        called.emplace_back(value);
+
+        if (value == 1) {
+            delivery->push(2);
+            delivery->push(3);
+        }
+    });
+
+    delivery->push(1);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 3}));
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 0);
+}
+
+YAS_TEST(delivery, cancel) {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+
+    auto const delivery = observing::delivery<int>::make_shared(
+        executor, [&called](int const &value) { called.emplace_back(value); });
+
+    delivery->push(1);
+    delivery->cancel();
+
+    YAS_TEST_ASSERT(delivery->is_cancelled());
+
+    executor->process();
+    delivery->push(2);
+    executor->process();
+
+    YAS_TEST_ASSERT(called.empty());
+}
+
+YAS_TEST(delivery, handler_throws) {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+    std::size_t error_count = 0;
+    delivery_ptr<int> delivery = nullptr;
+
+    delivery = observing::delivery<int>::make_shared(
+        executor,
+        [&called, &delivery](int const &value) {
+            called.emplace_back(value);
+
+            if (value == 1) {
+                delivery->push(2);
+                throw std::runtime_error("handler thrown");
+            } else if (value == 3) {
+                throw std::runtime_error("handler thrown");
+            }
+        },
+        [&error_count](std::exception_ptr const &exception) {
+            if (exception) {
+                ++error_count;
+            }
+        });
+
+    delivery->push(1);
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(error_count, 1);
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2}));
+
+    delivery->push(3);
+    executor->process();
+    delivery->push(4);
+
+    YAS_TEST_ASSERT_EQUAL(error_count, 2);
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3, 4}));
+}
+
+YAS_TEST(delivery, handler_throws_on_thread_pool) {
+    auto const executor = thread_pool_executor::make_shared(1);
+
+    std::promise<void> promise;
+    delivery_ptr<int> delivery = nullptr;
+
+    delivery = observing::delivery<int>::make_shared(executor, [&delivery, &promise](int const &value) {
+        if (value == 1) {
+            delivery->push(2);
+            throw std::runtime_error("handler thrown");
+        }
+        promise.set_value();
+    });
+
+    delivery->push(1);
+
+    YAS_TEST_ASSERT(promise.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+}
+
+YAS_TEST(delivery, release_delivered_value) {
+    auto const executor = executor_stub::make_shared();
+
+    auto const delivery =
+        observing::delivery<std::shared_ptr<int>>::make_shared(executor, [](std::shared_ptr<int> const &) {});
+
+    auto first = std::make_shared<int>(1);
+    std::weak_ptr<int> const weak_first = first;
+
+    delivery->push(first);
+    first = nullptr;
+    executor->process();
+
+    YAS_TEST_ASSERT(weak_first.expired());
+
+    auto second = std::make_shared<int>(2);
+    std::weak_ptr<int> const weak_second = second;
+
+    delivery->push(second);
+    second = nullptr;
+    executor->process();
+
+    YAS_TEST_ASSERT(weak_second.expired());
+}
+
+YAS_TEST(delivery, make_shared_without_executor) {
+    YAS_TEST_ASSERT_THROWS(observing::delivery<int>::make_shared(nullptr, [](int const &) {}));
+}
+
+YAS_TEST(delivery, notifier_observe_on) {
+    auto const executor = executor_stub::make_shared();
+    auto const notifier = observing::notifier<int>::make_shared();
+
+    std::vector<int> called;
+
+    auto canceller = notifier->observe_on(executor, [&called](int const &value) { called.emplace_back(value); }).end();
+
+    notifier->notify(1);
+    notifier->notify(2);
+
+    YAS_TEST_ASSERT(called.empty());
+
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{2}));
+
+    notifier->notify(3);
+    canceller->cancel();
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{2}));
+}
+
+YAS_TEST(delivery, value_holder_observe_on) {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = value::holder<int>::make_shared(100);
+
+    std::vector<int> called;
+
+    auto canceller = holder->observe_on(executor, [&called](int const &value) { called.emplace_back(value); }).sync();
+
+    YAS_TEST_ASSERT(called.empty());
+
+    holder->set_value(101);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{101}));
+
+    canceller->cancel();
+}
+
+YAS_TEST(delivery, vector_holder_observe_on) {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = vector::holder<int>::make_shared({1});
+
+    std::vector<std::vector<int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::vector<int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->push_back(2);
+    holder->erase(0);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<std::vector<int>>{{2}}));
+
+    canceller->cancel();
+}
+
+YAS_TEST(delivery, map_holder_observe_on) {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = map::holder<int, int>::make_shared();
+
+    std::vector<std::map<int, int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::map<int, int> const &elements) { called.emplace_back(elements); })
+                         .end();
+
+    holder->insert_or_replace(1, 10);
+    holder->insert_or_replace(2, 20);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<std::map<int, int>>{{{1, 10}, {2, 20}}}));
+
+    canceller->cancel();
+}
+
+YAS_TEST(delivery, vector_holder_observe_on_changes) {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = vector::holder<int>::make_shared({1, 2, 3});
+
+    std::vector<std::vector<int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::vector<int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->replace(10, 0);
+    holder->insert(5, 1);
+    holder->push_back(4);
+    holder->erase(2);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<std::vector<int>>{{10, 5, 3, 4}}));
+
+    holder->erase(0);
+    holder->replace(20, 0);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<std::vector<int>>{{10, 5, 3, 4}, {20, 3, 4}}));
+
+    canceller->cancel();
+}
+
+YAS_TEST(delivery, map_holder_observe_on_changes) {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = map::holder<int, int>::make_shared({{1, 10}, {2, 20}});
+
+    std::vector<std::map<int, int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::map<int, int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->insert_or_replace(1, 11);
+    holder->insert_or_replace(3, 30);
+    holder->erase(2);
+    executor->process();
+
+    YAS_TEST_ASSERT((called == std::vector<std::map<int, int>>{{{1, 11}, {3, 30}}}));
+
+    canceller->cancel();
+}
+
+YAS_TEST(delivery, notify_to_thread_pool) {
+    auto const executor = thread_pool_executor::make_shared(2);
+    auto const notifier = observing::notifier<int>::make_shared();
+
+    int const last_value = 10000;
+    std::atomic<int> previous = -1;
+    std::atomic<bool> is_ordered = true;
+    std::promise<void> promise;
+
+    auto canceller = notifier
+                         ->observe_on(executor,
+                                      [&previous, &is_ordered, &promise](int const &value) {
+                                          // the deliveries are not concurrent and the values do not go backward.
+                                          if (previous.exchange(value) >= value) {
+                                              is_ordered = false;
+                                          }
+                                          if (value == last_value) {
+                                              promise.set_value();
+                                          }
+                                      })
+                         .end();
+
+    for (int value = 0; value <= last_value; ++value) {
+        notifier->notify(value);
+    }
+
+    promise.get_future().wait();
+    canceller->cancel();
+
+    YAS_TEST_ASSERT(is_ordered);
+}
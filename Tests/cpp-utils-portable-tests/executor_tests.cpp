@@ -0,0 +1,91 @@
+//
+//  executor_tests.cpp
+//
+
+#include <cpp-utils/executor.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(executor, thread_pool_execute) {
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    auto const executor = thread_pool_executor::make_shared();
+
+    executor->execute([&promise] { promise.set_value(); });
+
+    YAS_TEST_ASSERT(future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+}
+
+YAS_TEST(executor, thread_pool_reuses_thread) {
+    auto const executor = thread_pool_executor::make_shared(1);
+
+    std::promise<std::thread::id> promise_1;
+    std::promise<std::thread::id> promise_2;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+
+    executor->execute([&promise_1] { promise_1.set_value(std::this_thread::get_id()); });
+    executor->execute([&promise_2] { promise_2.set_value(std::this_thread::get_id()); });
+
+    YAS_TEST_ASSERT_EQUAL(future_1.get(), future_2.get());
+}
+
+YAS_TEST(executor, thread_pool_thread_count) {
+    YAS_TEST_ASSERT_EQUAL(thread_pool_executor::make_shared()->thread_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(thread_pool_executor::make_shared(4)->thread_count(), 4);
+    YAS_TEST_ASSERT_THROWS(thread_pool_executor::make_shared(0));
+}
+
+YAS_TEST(executor, thread_pool_concurrent) {
+    auto const executor = thread_pool_executor::make_shared(2);
+
+    std::promise<void> promise_1;
+    std::promise<void> promise_2;
+    std::promise<void> end_promise;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+    auto end_future = end_promise.get_future();
+
+    executor->execute([&promise_1, &future_2, &end_promise] {
+        promise_1.set_value();
+        future_2.get();
+        end_promise.set_value();
+    });
+    executor->execute([&promise_2, &future_1] {
+        future_1.get();
+        promise_2.set_value();
+    });
+
+    YAS_TEST_ASSERT_EQUAL(end_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
+
+YAS_TEST(executor, stub) {
+    auto const executor = executor_stub::make_shared();
+
+    int called = 0;
+
+    executor->execute([&called, &executor] {
+        ++called;
+        executor->execute([&called] { ++called; });
+    });
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(called, 0);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(called, 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 0);
+    YAS_TEST_ASSERT_EQUAL(called, 2);
+}
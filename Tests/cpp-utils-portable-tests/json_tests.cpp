@@ -0,0 +1,88 @@
+//
+//  json_tests.cpp
+//
+
+#include <cpp-utils/json.h>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(json, to_json_string_from_vector) {
+    json_value const integer_value{int64_t{1}};
+    json_value const string_value{"test_value"};
+    json_value const vector_value{json_vector{integer_value, string_value}};
+
+    YAS_TEST_ASSERT_EQUAL(to_json_string(vector_value), "[1,\"test_value\"]");
+}
+
+YAS_TEST(json, to_json_string_from_map) {
+    json_value const integer_value{int64_t{1}};
+    json_value const string_value{"test_value"};
+    json_value const map_value{json_map{{"integer", integer_value}, {"string", string_value}}};
+
+    YAS_TEST_ASSERT_EQUAL(to_json_string(map_value), "{\"integer\":1,\"string\":\"test_value\"}");
+}
+
+YAS_TEST(json, to_json_string_escaped) {
+    json_value const value{json_vector{json_value{std::string{"a\"b\\c/d\n\x01"}}, json_value{0.5}, json_value{2.0}}};
+
+    YAS_TEST_ASSERT_EQUAL(to_json_string(value), "[\"a\\\"b\\\\c\\/d\\n\\u0001\",0.5,2.0]");
+}
+
+YAS_TEST(json, to_json_string_not_container) {
+    YAS_TEST_ASSERT_EQUAL(to_json_string(json_value{int64_t{1}}), "");
+    YAS_TEST_ASSERT_EQUAL(to_json_string(json_value{std::nullopt}), "");
+}
+
+YAS_TEST(json, to_json_value_from_array) {
+    auto const json_value = to_json_value("[1,\"test_value\"]");
+
+    YAS_TEST_ASSERT(json_value.vector.has_value());
+    auto const &vector_value = json_value.vector.value();
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(0).integer.value(), 1);
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(1).string.value(), "test_value");
+}
+
+YAS_TEST(json, to_json_value_from_dictionary) {
+    auto const json_value = to_json_value("{\"integer\":1,\"string\":\"test_value\"}");
+
+    YAS_TEST_ASSERT(json_value.map.has_value());
+    auto const &map_value = json_value.map.value();
+    YAS_TEST_ASSERT_EQUAL(map_value.at("integer").integer.value(), 1);
+    YAS_TEST_ASSERT_EQUAL(map_value.at("string").string.value(), "test_value");
+}
+
+YAS_TEST(json, to_json_value_literals) {
+    auto const json_value = to_json_value(" { \"a\" : [ -1.5e2 , true , false , null , \"\\u00e9\\ud83d\\ude00\" ] } ");
+
+    YAS_TEST_ASSERT(json_value.map.has_value());
+    auto const &vector_value = json_value.map.value().at("a").vector.value();
+    YAS_TEST_ASSERT_EQUAL(vector_value.size(), 4);
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(0).real.value(), -150.0);
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(1).integer.value(), 1);
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(2).integer.value(), 0);
+    YAS_TEST_ASSERT_EQUAL(vector_value.at(3).string.value(), "\xC3\xA9\xF0\x9F\x98\x80");
+}
+
+YAS_TEST(json, to_json_value_invalid) {
+    YAS_TEST_ASSERT(to_json_value("").is_empty());
+    YAS_TEST_ASSERT(to_json_value("1").is_empty());
+    YAS_TEST_ASSERT(to_json_value("[1,]").is_empty());
+    YAS_TEST_ASSERT(to_json_value("{\"a\":1").is_empty());
+    YAS_TEST_ASSERT(to_json_value("[1] 2").is_empty());
+    YAS_TEST_ASSERT(to_json_value(std::string(1000, '[')).is_empty());
+}
+
+YAS_TEST(json, round_trip) {
+    json_value const value{json_map{{"vector", json_value{json_vector{json_value{int64_t{-3}}, json_value{0.25}}}},
+                                    {"string", json_value{std::string{"tab\there"}}}}};
+
+    auto const result = to_json_value(to_json_string(value));
+
+    YAS_TEST_ASSERT(result.map.has_value());
+    auto const &map_value = result.map.value();
+    YAS_TEST_ASSERT_EQUAL(map_value.at("vector").vector.value().at(0).integer.value(), -3);
+    YAS_TEST_ASSERT_EQUAL(map_value.at("vector").vector.value().at(1).real.value(), 0.25);
+    YAS_TEST_ASSERT_EQUAL(map_value.at("string").string.value(), "tab\there");
+}
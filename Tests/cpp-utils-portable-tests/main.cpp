@@ -0,0 +1,52 @@
+//
+//  main.cpp
+//
+
+#include <cpp-utils-allocation-counter/allocation_counter.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "test.h"
+
+using namespace yas;
+
+std::vector<test::test_case> &test::test_cases() {
+    static std::vector<test_case> cases;
+    return cases;
+}
+
+std::size_t test::heap_allocation_count() {
+    return allocation_counter::count();
+}
+
+// runs all of the tests, or the tests of a suite ("json") or a single test ("json.to_json_string_from_map").
+int main(int argc, char *argv[]) {
+    char const *const filter = argc > 1 ? argv[1] : nullptr;
+
+    std::size_t run_count = 0;
+    std::size_t failed_count = 0;
+
+    for (auto const &test_case : test::test_cases()) {
+        std::string const full_name = std::string(test_case.suite) + "." + test_case.name;
+
+        if (filter && std::strcmp(filter, test_case.suite) != 0 && full_name != filter) {
+            continue;
+        }
+
+        ++run_count;
+
+        try {
+            test_case.function();
+            std::printf("[  OK  ] %s\n", full_name.c_str());
+        } catch (std::exception const &exception) {
+            ++failed_count;
+            std::printf("[ FAIL ] %s\n  %s\n", full_name.c_str(), exception.what());
+        }
+    }
+
+    std::printf("%zu tests, %zu failed\n", run_count, failed_count);
+
+    return (run_count == 0 || failed_count > 0) ? 1 : 0;
+}
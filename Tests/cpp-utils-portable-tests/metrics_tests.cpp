@@ -0,0 +1,84 @@
+//
+//  metrics_tests.cpp
+//
+
+#include <cpp-utils/metrics.h>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(metrics, bucket_index) {
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_index(std::chrono::nanoseconds(0)), 0);
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_index(std::chrono::nanoseconds(1)), 1);
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_index(std::chrono::nanoseconds(3)), 2);
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_index(std::chrono::nanoseconds(4)), 3);
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_index(std::chrono::hours(100)),
+                          duration_histogram::bucket_count - 1);
+
+    YAS_TEST_ASSERT_EQUAL(duration_histogram::bucket_upper_bound(2), std::chrono::nanoseconds(3));
+    YAS_TEST_ASSERT_THROWS(duration_histogram::bucket_upper_bound(duration_histogram::bucket_count));
+}
+
+YAS_TEST(metrics, histogram) {
+    duration_histogram histogram;
+
+    YAS_TEST_ASSERT_EQUAL(histogram.count(), 0);
+    YAS_TEST_ASSERT_EQUAL(histogram.percentile(0.5), std::chrono::nanoseconds::zero());
+
+    for (int idx = 0; idx < 90; ++idx) {
+        histogram.record(std::chrono::nanoseconds(100));
+    }
+    for (int idx = 0; idx < 10; ++idx) {
+        histogram.record(std::chrono::microseconds(10));
+    }
+
+    YAS_TEST_ASSERT_EQUAL(histogram.count(), 100);
+    YAS_TEST_ASSERT_EQUAL(histogram.count_at(duration_histogram::bucket_index(std::chrono::nanoseconds(100))), 90);
+    YAS_TEST_ASSERT_EQUAL(histogram.total(), std::chrono::nanoseconds(9000) + std::chrono::microseconds(100));
+    YAS_TEST_ASSERT_EQUAL(histogram.max(), std::chrono::microseconds(10));
+    YAS_TEST_ASSERT_EQUAL(histogram.percentile(0.5), std::chrono::nanoseconds(127));
+    YAS_TEST_ASSERT_EQUAL(histogram.percentile(0.99), std::chrono::microseconds(10));
+    YAS_TEST_ASSERT_THROWS(histogram.percentile(1.5));
+
+    histogram.reset();
+
+    YAS_TEST_ASSERT_EQUAL(histogram.count(), 0);
+    YAS_TEST_ASSERT_EQUAL(histogram.max(), std::chrono::nanoseconds::zero());
+}
+
+YAS_TEST(metrics, task_queue_metrics) {
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    YAS_TEST_ASSERT_EQUAL(metrics->priority_count(), 2);
+
+    metrics->add_queue_depth(3);
+    metrics->subtract_queue_depth(2);
+    metrics->add_cancellation_count(4);
+    metrics->record_waiting(1, std::chrono::nanoseconds(10));
+    metrics->record_execution(0, std::chrono::nanoseconds(20));
+
+    YAS_TEST_ASSERT_EQUAL(metrics->queue_depth(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->max_queue_depth(), 3);
+    YAS_TEST_ASSERT_EQUAL(metrics->cancellation_count(), 4);
+    YAS_TEST_ASSERT_EQUAL(metrics->waiting(1).count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->execution(0).count(), 1);
+    YAS_TEST_ASSERT_THROWS(metrics->waiting(2));
+    YAS_TEST_ASSERT_THROWS(task_queue_metrics::make_shared(0));
+}
+
+YAS_TEST(metrics, worker_metrics) {
+    auto const metrics = worker_metrics::make_shared();
+
+    YAS_TEST_ASSERT_EQUAL(metrics->busy_ratio(), 0.0);
+
+    metrics->record_busy(true, std::chrono::nanoseconds(100));
+    metrics->record_busy(false, std::chrono::nanoseconds(200));
+    metrics->record_idle(std::chrono::nanoseconds(700));
+
+    YAS_TEST_ASSERT_EQUAL(metrics->processed_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->unprocessed_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->busy_duration(), std::chrono::nanoseconds(300));
+    YAS_TEST_ASSERT_EQUAL(metrics->idle_duration(), std::chrono::nanoseconds(700));
+    YAS_TEST_ASSERT_EQUAL(metrics->busy_ratio(), 0.3);
+}
@@ -0,0 +1,160 @@
+//
+//  multi_thread_worker_tests.cpp
+//
+
+#include <cpp-utils/multi_thread_worker.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(multi_thread_worker, make_shared) {
+    auto const worker = multi_thread_worker::make_shared(2, worker_fairness::weighted_round_robin);
+
+    YAS_TEST_ASSERT_EQUAL(worker->thread_count(), 2);
+    YAS_TEST_ASSERT_EQUAL(worker->fairness(), worker_fairness::weighted_round_robin);
+
+    YAS_TEST_ASSERT_EQUAL(multi_thread_worker::make_shared(1)->fairness(), worker_fairness::strict_priority);
+    YAS_TEST_ASSERT_THROWS(multi_thread_worker::make_shared(0));
+}
+
+YAS_TEST(multi_thread_worker, add_task_with_invalid_option) {
+    auto const worker = multi_thread_worker::make_shared(2);
+
+    YAS_TEST_ASSERT_THROWS(worker->add_task(0, [] { return worker_task_result::completed; }, {.thread_index = 2}));
+    YAS_TEST_ASSERT_THROWS(worker->add_task(0, [] { return worker_task_result::completed; }, {.weight = 0}));
+    YAS_TEST_ASSERT_THROWS(worker->start());
+}
+
+YAS_TEST(multi_thread_worker, strict_priority_does_not_starve_with_threads) {
+    auto const worker = multi_thread_worker::make_shared(2);
+
+    // the task may be still running after stop(), so the counts are shared with it.
+    auto const running_count = std::make_shared<std::atomic<int>>(0);
+    auto const is_overlapped = std::make_shared<std::atomic<bool>>(false);
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(0, [running_count, is_overlapped] {
+        if (++*running_count > 1) {
+            *is_overlapped = true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        --*running_count;
+        return worker_task_result::processed;
+    });
+    worker->add_task(1, [&promise] {
+        promise.set_value();
+        return worker_task_result::completed;
+    });
+
+    worker->start();
+
+    YAS_TEST_ASSERT_EQUAL(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+
+    YAS_TEST_ASSERT_FALSE(*is_overlapped);
+}
+
+YAS_TEST(multi_thread_worker, weighted_round_robin) {
+    auto const worker = multi_thread_worker::make_shared(1, worker_fairness::weighted_round_robin);
+
+    std::mutex mutex;
+    std::vector<int> called;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(
+        0,
+        [&mutex, &called] {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (called.size() >= 8) {
+                return worker_task_result::completed;
+            }
+            called.push_back(0);
+            return worker_task_result::processed;
+        },
+        {.weight = 3});
+    worker->add_task(1, [&mutex, &called, &promise] {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (called.size() >= 8) {
+            promise.set_value();
+            return worker_task_result::completed;
+        }
+        called.push_back(1);
+        return worker_task_result::processed;
+    });
+
+    worker->start();
+
+    YAS_TEST_ASSERT_EQUAL(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{0, 0, 0, 1, 0, 0, 0, 1}));
+}
+
+YAS_TEST(multi_thread_worker, thread_index) {
+    auto const worker = multi_thread_worker::make_shared(3);
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<int> count = 0;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(
+        0,
+        [&mutex, &thread_ids, &count, &promise] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            }
+            if (++count == 1000) {
+                promise.set_value();
+                return worker_task_result::completed;
+            }
+            return worker_task_result::processed;
+        },
+        {.thread_index = 1});
+
+    worker->start();
+
+    YAS_TEST_ASSERT_EQUAL(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    YAS_TEST_ASSERT_EQUAL(thread_ids.size(), 1);
+}
+
+YAS_TEST(multi_thread_worker, wake) {
+    auto const worker = multi_thread_worker::make_shared(2, worker_fairness::strict_priority, std::chrono::seconds(10));
+
+    std::atomic<bool> has_work = false;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(0, [&has_work, &promise] {
+        if (has_work.exchange(false)) {
+            promise.set_value();
+            return worker_task_result::completed;
+        }
+        return worker_task_result::unprocessed;
+    });
+
+    worker->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    has_work = true;
+    worker->wake();
+
+    YAS_TEST_ASSERT_EQUAL(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+}
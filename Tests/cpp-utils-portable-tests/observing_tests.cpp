@@ -0,0 +1,72 @@
+//
+//  observing_tests.cpp
+//
+
+#include <observing/umbrella.hpp>
+
+#include "test.h"
+
+using namespace yas;
+using namespace yas::observing;
+
+YAS_TEST(observing, notify) {
+    auto const notifier = observing::notifier<int>::make_shared();
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto const canceller1 = notifier->observe([&called1](int const &value) { called1.emplace_back(value); }).end();
+    auto const canceller2 = notifier->observe([&called2](int const &value) { called2.emplace_back(value); }).end();
+
+    notifier->notify(1);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1}));
+
+    canceller1->cancel();
+
+    notifier->notify(2);
+
+    YAS_TEST_ASSERT((called1 == std::vector<int>{1}));
+    YAS_TEST_ASSERT((called2 == std::vector<int>{1, 2}));
+}
+
+YAS_TEST(observing, value_holder_observe_with_sync) {
+    auto const holder = value::holder<int>::make_shared(100);
+
+    std::vector<int> called;
+
+    auto canceller = holder->observe([&called](int const &value) { called.emplace_back(value); }).sync();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{100}));
+
+    holder->set_value(101);
+    holder->set_value(101);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{100, 101}));
+
+    canceller->cancel();
+    holder->set_value(102);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{100, 101}));
+}
+
+YAS_TEST(observing, notify_recursively_with_queue) {
+    auto const notifier = observing::notifier<int>::make_shared(caller_reentrancy::queue);
+
+    std::vector<int> called;
+
+    auto const canceller = notifier
+                               ->observe([&notifier, &called](int const &value) {
+                                   called.emplace_back(value);
+
+                                   if (value < 2) {
+                                       notifier->notify(value + 1);
+                                   }
+                               })
+                               .end();
+
+    notifier->notify(0);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2}));
+}
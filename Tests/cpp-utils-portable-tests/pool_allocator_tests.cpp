@@ -0,0 +1,111 @@
+//
+//  pool_allocator_tests.cpp
+//
+
+#include <cpp-utils/pool_allocator.h>
+
+#include <array>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace yas;
+
+namespace yas::pool_allocator_test {
+struct element {
+    std::array<std::byte, 40> bytes;
+};
+}  // namespace yas::pool_allocator_test
+
+YAS_TEST(pool_allocator, reuse) {
+    using element = pool_allocator_test::element;
+
+    pool_allocator<element> allocator;
+    auto &pool = pool_allocator<element>::pool_t::shared();
+
+    auto *const ptr_1 = allocator.allocate(1);
+    allocator.deallocate(ptr_1, 1);
+
+    std::size_t const heap_block_count = pool.heap_block_count();
+
+    auto *const ptr_2 = allocator.allocate(1);
+
+    YAS_TEST_ASSERT_EQUAL(ptr_1, ptr_2);
+    YAS_TEST_ASSERT_EQUAL(pool.heap_block_count(), heap_block_count);
+
+    allocator.deallocate(ptr_2, 1);
+}
+
+YAS_TEST(pool_allocator, reuse_freed_on_other_thread) {
+    using element = pool_allocator_test::element;
+
+    pool_allocator<element> allocator;
+    auto &pool = pool_allocator<element>::pool_t::shared();
+
+    auto *const ptr_1 = allocator.allocate(1);
+
+    std::thread thread{[ptr_1] { pool_allocator<element>{}.deallocate(ptr_1, 1); }};
+    thread.join();
+
+    std::size_t const heap_block_count = pool.heap_block_count();
+
+    auto *const ptr_2 = allocator.allocate(1);
+
+    YAS_TEST_ASSERT_EQUAL(pool.heap_block_count(), heap_block_count);
+
+    allocator.deallocate(ptr_2, 1);
+}
+
+YAS_TEST(pool_allocator, give_back_surplus_of_cache) {
+    using element = pool_allocator_test::element;
+
+    pool_allocator<element> allocator;
+    auto &pool = pool_allocator<element>::pool_t::shared();
+    std::size_t const capacity = pool_allocator<element>::pool_t::cache_capacity;
+
+    std::vector<element *> ptrs;
+    for (std::size_t idx = 0; idx < capacity * 4; ++idx) {
+        ptrs.emplace_back(allocator.allocate(1));
+    }
+
+    std::promise<void> freed_promise;
+    std::promise<void> finish_promise;
+
+    // the freeing thread is alive while reallocating, so the blocks left in its cache are not given back.
+    std::thread thread{[&ptrs, &freed_promise, finish_future = finish_promise.get_future()] {
+        for (auto *const ptr : ptrs) {
+            pool_allocator<element>{}.deallocate(ptr, 1);
+        }
+        freed_promise.set_value();
+        finish_future.wait();
+    }};
+
+    freed_promise.get_future().wait();
+
+    std::size_t const heap_block_count = pool.heap_block_count();
+
+    for (auto &ptr : ptrs) {
+        ptr = nullptr;
+    }
+    for (std::size_t idx = 0; idx < capacity * 3; ++idx) {
+        ptrs.at(idx) = allocator.allocate(1);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(pool.heap_block_count(), heap_block_count);
+
+    finish_promise.set_value();
+    thread.join();
+
+    for (auto *const ptr : ptrs) {
+        allocator.deallocate(ptr, 1);
+    }
+}
+
+YAS_TEST(pool_allocator, shared_ptr) {
+    auto const shared = std::allocate_shared<int>(pool_allocator<int>{}, 3);
+
+    YAS_TEST_ASSERT_EQUAL(*shared, 3);
+}
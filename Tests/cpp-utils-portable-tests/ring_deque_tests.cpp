@@ -0,0 +1,92 @@
+//
+//  ring_deque_tests.cpp
+//
+
+#include <cpp-utils/ring_deque.h>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(ring_deque, push_and_pop) {
+    ring_deque<int> deque;
+
+    YAS_TEST_ASSERT(deque.empty());
+
+    deque.emplace_back(2);
+    deque.emplace_back(3);
+    deque.emplace_front(1);
+
+    YAS_TEST_ASSERT_EQUAL(deque.size(), 3);
+    YAS_TEST_ASSERT_EQUAL(deque.front(), 1);
+    YAS_TEST_ASSERT_EQUAL(deque.back(), 3);
+    YAS_TEST_ASSERT_EQUAL(deque.at(1), 2);
+    YAS_TEST_ASSERT_THROWS(deque.at(3));
+
+    deque.pop_front();
+
+    YAS_TEST_ASSERT_EQUAL(deque.front(), 2);
+
+    deque.pop_back();
+
+    YAS_TEST_ASSERT_EQUAL(deque.size(), 1);
+    YAS_TEST_ASSERT_EQUAL(deque.back(), 2);
+
+    deque.clear();
+
+    YAS_TEST_ASSERT(deque.empty());
+    YAS_TEST_ASSERT_THROWS(deque.pop_front());
+}
+
+YAS_TEST(ring_deque, grow) {
+    ring_deque<int> deque(4);
+
+    YAS_TEST_ASSERT_EQUAL(deque.capacity(), 4);
+
+    deque.emplace_back(2);
+    deque.emplace_back(3);
+    deque.pop_front();
+    deque.emplace_back(4);
+    deque.emplace_back(5);
+    deque.emplace_front(1);
+    deque.emplace_back(6);
+
+    YAS_TEST_ASSERT_EQUAL(deque.capacity(), 8);
+
+    std::vector<int> values;
+    for (auto const &value : deque) {
+        values.emplace_back(value);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(values, (std::vector<int>{1, 3, 4, 5, 6}));
+}
+
+YAS_TEST(ring_deque, not_grow_in_steady_state) {
+    ring_deque<int> deque;
+
+    for (int idx = 0; idx < 1000; ++idx) {
+        deque.emplace_back(idx);
+        deque.emplace_back(idx);
+        deque.pop_front();
+        deque.pop_front();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(deque.capacity(), 16);
+}
+
+YAS_TEST(ring_deque, erase_if) {
+    ring_deque<int> deque;
+
+    for (int idx = 0; idx < 10; ++idx) {
+        deque.emplace_back(idx);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(deque.erase_if([](int const value) { return value % 2 == 0; }), 5);
+
+    std::vector<int> values;
+    for (auto const &value : deque) {
+        values.emplace_back(value);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(values, (std::vector<int>{1, 3, 5, 7, 9}));
+}
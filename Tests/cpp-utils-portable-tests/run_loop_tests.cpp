@@ -0,0 +1,208 @@
+//
+//  run_loop_tests.cpp
+//
+
+#include <cpp-utils/run_loop.h>
+#include <cpp-utils/thread.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(run_loop, process_in_posted_order) {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called] { called.push_back(1); });
+    loop->execute([&called] { called.push_back(2); });
+    loop->execute([&called] { called.push_back(3); });
+
+    YAS_TEST_ASSERT(called.empty());
+
+    YAS_TEST_ASSERT_EQUAL(loop->process(), 3);
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3}));
+
+    YAS_TEST_ASSERT_EQUAL(loop->process(), 0);
+}
+
+YAS_TEST(run_loop, leave_posted_while_processing) {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called, &loop] {
+        called.push_back(1);
+        loop->execute([&called] { called.push_back(2); });
+    });
+
+    YAS_TEST_ASSERT_EQUAL(loop->process(), 1);
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+
+    YAS_TEST_ASSERT_EQUAL(loop->process(), 1);
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2}));
+}
+
+YAS_TEST(run_loop, leave_rest_after_throwing) {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called, &loop] {
+        called.push_back(1);
+        loop->execute([&called] { called.push_back(4); });
+        throw std::runtime_error("execution thrown");
+    });
+    loop->execute([&called] { called.push_back(2); });
+    loop->execute([&called] { called.push_back(3); });
+
+    YAS_TEST_ASSERT_THROWS(loop->process());
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+
+    YAS_TEST_ASSERT_EQUAL(loop->process(), 3);
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3, 4}));
+}
+
+YAS_TEST(run_loop, process_on_other_thread) {
+    auto const loop = run_loop::make_shared();
+
+    YAS_TEST_ASSERT(loop->is_current());
+
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+
+    std::thread{[&loop, &promise] {
+        bool is_thrown = false;
+
+        try {
+            loop->process();
+        } catch (std::runtime_error const &) {
+            is_thrown = true;
+        }
+
+        promise.set_value(!loop->is_current() && is_thrown);
+    }}.join();
+
+    YAS_TEST_ASSERT(future.get());
+}
+
+YAS_TEST(run_loop, destroy_without_processing) {
+    auto const shared = std::make_shared<int>(0);
+
+    {
+        auto const loop = run_loop::make_shared();
+        loop->execute([shared] { ++*shared; });
+
+        YAS_TEST_ASSERT_EQUAL(shared.use_count(), 2);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(shared.use_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(*shared, 0);
+}
+
+YAS_TEST(run_loop, run_until_stop) {
+    std::promise<run_loop_ptr> promise;
+    auto future = promise.get_future();
+    std::atomic<std::size_t> count = 0;
+
+    std::thread loop_thread{[&promise] {
+        auto const loop = run_loop::make_shared();
+        promise.set_value(loop);
+        loop->run();
+    }};
+
+    auto const loop = future.get();
+
+    std::size_t const thread_count = 4;
+    std::size_t const post_count = 10000;
+    std::vector<std::thread> threads;
+
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        threads.emplace_back([&loop, &count] {
+            for (std::size_t idx = 0; idx < post_count; ++idx) {
+                loop->execute([&count, &loop] {
+                    if (loop->is_current()) {
+                        ++count;
+                    }
+                });
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::promise<void> done_promise;
+    loop->execute([&done_promise] { done_promise.set_value(); });
+    done_promise.get_future().wait();
+
+    loop->stop();
+    loop_thread.join();
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), thread_count * post_count);
+}
+
+YAS_TEST(run_loop, stop_before_run) {
+    auto const loop = run_loop::make_shared();
+
+    bool is_called = false;
+
+    loop->execute([&is_called] { is_called = true; });
+    loop->stop();
+    loop->run();
+
+    YAS_TEST_ASSERT(is_called);
+}
+
+YAS_TEST(run_loop, main) {
+    auto const main_loop = run_loop::main();
+
+    YAS_TEST_ASSERT(main_loop);
+    YAS_TEST_ASSERT(main_loop->is_current());
+    YAS_TEST_ASSERT_THROWS(run_loop::set_main(nullptr));
+
+    bool is_called = false;
+
+    thread::perform_async_on_main([&is_called] { is_called = true; });
+
+    YAS_TEST_ASSERT_EQUAL(main_loop->process(), 1);
+    YAS_TEST_ASSERT(is_called);
+}
+
+YAS_TEST(run_loop, set_main) {
+    auto const default_loop = run_loop::main();
+
+    std::promise<run_loop_ptr> promise;
+    auto future = promise.get_future();
+
+    std::thread loop_thread{[&promise] {
+        auto const loop = run_loop::make_shared();
+        run_loop::set_main(loop);
+        promise.set_value(loop);
+        loop->run();
+    }};
+
+    auto const loop = future.get();
+
+    YAS_TEST_ASSERT(run_loop::main() == loop);
+    YAS_TEST_ASSERT_FALSE(thread::is_main());
+
+    std::atomic<bool> is_main = false;
+
+    thread::perform_sync_on_main([&is_main] { is_main = thread::is_main(); });
+
+    YAS_TEST_ASSERT(is_main);
+
+    run_loop::set_main(default_loop);
+    loop->stop();
+    loop_thread.join();
+
+    YAS_TEST_ASSERT(thread::is_main());
+}
@@ -0,0 +1,81 @@
+//
+//  small_function_tests.cpp
+//
+
+#include <cpp-utils/small_function.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(small_function, call) {
+    small_function<int(int)> const function = [](int const value) { return value + 1; };
+
+    YAS_TEST_ASSERT(function);
+    YAS_TEST_ASSERT_EQUAL(function(1), 2);
+}
+
+YAS_TEST(small_function, empty) {
+    small_function<void(void)> const function;
+
+    YAS_TEST_ASSERT_FALSE(function);
+    YAS_TEST_ASSERT_THROWS(function());
+
+    small_function<void(void)> const null_function = nullptr;
+
+    YAS_TEST_ASSERT_FALSE(null_function);
+
+    std::function<void(void)> std_function;
+    small_function<void(void)> const from_empty = std_function;
+
+    YAS_TEST_ASSERT_FALSE(from_empty);
+}
+
+YAS_TEST(small_function, inline) {
+    int captured = 2;
+    small_function<int(void)> const small = [captured] { return captured; };
+
+    YAS_TEST_ASSERT(small.is_inline());
+    YAS_TEST_ASSERT_EQUAL(small(), 2);
+
+    std::array<int, 64> array{};
+    array.at(0) = 3;
+    small_function<int(void)> const large = [array] { return array.at(0); };
+
+    YAS_TEST_ASSERT_FALSE(large.is_inline());
+    YAS_TEST_ASSERT_EQUAL(large(), 3);
+}
+
+YAS_TEST(small_function, move) {
+    auto unique = std::make_unique<int>(4);
+    small_function<int(void)> function = [unique = std::move(unique)] { return *unique; };
+
+    small_function<int(void)> moved = std::move(function);
+
+    YAS_TEST_ASSERT_FALSE(function);
+    YAS_TEST_ASSERT_EQUAL(moved(), 4);
+
+    function = std::move(moved);
+
+    YAS_TEST_ASSERT_FALSE(moved);
+    YAS_TEST_ASSERT_EQUAL(function(), 4);
+
+    function = nullptr;
+
+    YAS_TEST_ASSERT_FALSE(function);
+}
+
+YAS_TEST(small_function, destroy) {
+    auto const shared = std::make_shared<int>(5);
+
+    {
+        small_function<void(void)> const function = [shared] {};
+        YAS_TEST_ASSERT_EQUAL(shared.use_count(), 2);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(shared.use_count(), 1);
+}
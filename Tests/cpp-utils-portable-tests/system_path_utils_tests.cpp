@@ -0,0 +1,46 @@
+//
+//  system_path_utils_tests.cpp
+//
+
+#include <cpp-utils/system_path_utils.h>
+
+#include <cstdlib>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(system_path_utils, temporary_path) {
+    auto const path = system_path_utils::directory_path(system_path_utils::dir::temporary);
+
+    YAS_TEST_ASSERT(path.string().size() > 0);
+}
+
+YAS_TEST(system_path_utils, home_path) {
+    ::setenv("HOME", "/home/test_user", 1);
+
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::home), "/home/test_user");
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::document),
+                          "/home/test_user/Documents");
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::downloads),
+                          "/home/test_user/Downloads");
+}
+
+YAS_TEST(system_path_utils, xdg_path) {
+    ::setenv("HOME", "/home/test_user", 1);
+    ::unsetenv("XDG_CACHE_HOME");
+
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::caches), "/home/test_user/.cache");
+
+    ::setenv("XDG_CACHE_HOME", "/var/cache/test_user", 1);
+
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::caches), "/var/cache/test_user");
+}
+
+YAS_TEST(system_path_utils, open_step_root_path) {
+    YAS_TEST_ASSERT_EQUAL(system_path_utils::directory_path(system_path_utils::dir::open_step_root), "/");
+}
+
+YAS_TEST(system_path_utils, unsupported_path) {
+    YAS_TEST_ASSERT_THROWS(system_path_utils::directory_path(system_path_utils::dir::all_libraries));
+}
@@ -0,0 +1,197 @@
+//
+//  task_future_tests.cpp
+//
+
+#include <cpp-utils/task_future.h>
+
+#include <stdexcept>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+namespace yas::test {
+static task_future<int> await_and_add(task_future<int> const future) {
+    int const value = co_await future;
+    co_return value + 1;
+}
+}  // namespace yas::test
+
+YAS_TEST(task_future, set_value) {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    YAS_TEST_ASSERT(future.is_valid());
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::pending);
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+    YAS_TEST_ASSERT_FALSE(promise.is_satisfied());
+
+    promise.set_value(1);
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::completed);
+    YAS_TEST_ASSERT(promise.is_satisfied());
+    YAS_TEST_ASSERT_EQUAL(future.get(), 1);
+
+    YAS_TEST_ASSERT_THROWS(promise.set_value(2));
+}
+
+YAS_TEST(task_future, set_value_void) {
+    task_promise<void> promise;
+    auto const future = promise.future();
+
+    promise.set_value();
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::completed);
+    future.get();
+}
+
+YAS_TEST(task_future, set_exception) {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    promise.set_exception(std::make_exception_ptr(std::logic_error("test")));
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::failed);
+    YAS_TEST_ASSERT_THROWS(future.get());
+}
+
+YAS_TEST(task_future, cancel_by_destruction) {
+    task_future<int> future;
+
+    YAS_TEST_ASSERT_FALSE(future.is_valid());
+    YAS_TEST_ASSERT_THROWS(future.status());
+
+    {
+        task_promise<int> promise;
+        future = promise.future();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::canceled);
+    YAS_TEST_ASSERT_THROWS(future.get());
+}
+
+YAS_TEST(task_future, cancel_by_destruction_with_throwing_continuation) {
+    task_future<int> future;
+    std::vector<int> called;
+
+    {
+        task_promise<int> promise;
+        future = promise.future();
+
+        future.on_completed([](auto const &) { throw std::runtime_error("continuation thrown"); });
+        future.on_completed([&called](auto const &) { called.push_back(1); });
+    }
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::canceled);
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+}
+
+YAS_TEST(task_future, on_completed) {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    std::vector<int> called;
+
+    future.on_completed([&called](auto const &future) { called.push_back(future.get()); });
+    future.on_completed([&called](auto const &future) { called.push_back(future.get() * 10); });
+
+    YAS_TEST_ASSERT_EQUAL(called.size(), 0);
+
+    promise.set_value(1);
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1, 10}));
+
+    future.on_completed([&called](auto const &future) { called.push_back(future.get() * 100); });
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1, 10, 100}));
+}
+
+YAS_TEST(task_future, on_completed_throwing) {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    std::vector<int> called;
+
+    future.on_completed([](auto const &) { throw std::runtime_error("continuation thrown"); });
+    future.on_completed([&called](auto const &future) { called.push_back(future.get()); });
+
+    YAS_TEST_ASSERT_THROWS(promise.set_value(1));
+    YAS_TEST_ASSERT((called == std::vector<int>{1}));
+    YAS_TEST_ASSERT_EQUAL(future.get(), 1);
+}
+
+YAS_TEST(task_future, wait) {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    YAS_TEST_ASSERT_FALSE(future.wait_for(std::chrono::milliseconds(1)));
+
+    std::thread thread{[promise = std::move(promise)]() mutable { promise.set_value(1); }};
+
+    future.wait();
+
+    YAS_TEST_ASSERT_EQUAL(future.get(), 1);
+
+    thread.join();
+}
+
+YAS_TEST(task_future, when_all) {
+    task_promise<int> promise0;
+    task_promise<int> promise1;
+
+    auto const future = when_all(std::vector<task_future<int>>{promise0.future(), promise1.future()});
+
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    promise1.set_value(1);
+
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    promise0.cancel();
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::completed);
+
+    YAS_TEST_ASSERT(when_all(std::vector<task_future<int>>{}).is_ready());
+}
+
+YAS_TEST(task_future, when_any) {
+    task_promise<int> promise0;
+    task_promise<int> promise1;
+
+    auto const future = when_any(std::vector<task_future<int>>{promise0.future(), promise1.future()});
+
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    promise1.set_value(1);
+
+    YAS_TEST_ASSERT_EQUAL(future.get(), 1);
+
+    promise0.set_value(0);
+
+    YAS_TEST_ASSERT_EQUAL(future.get(), 1);
+
+    YAS_TEST_ASSERT_THROWS(when_any(std::vector<task_future<int>>{}));
+}
+
+YAS_TEST(task_future, coroutine) {
+    task_promise<int> promise;
+
+    auto const future = test::await_and_add(promise.future());
+
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    promise.set_value(1);
+
+    YAS_TEST_ASSERT_EQUAL(future.get(), 2);
+}
+
+YAS_TEST(task_future, coroutine_canceled) {
+    task_promise<int> promise;
+
+    auto const future = test::await_and_add(promise.future());
+
+    promise.cancel();
+
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::canceled);
+}
@@ -0,0 +1,1208 @@
+//
+//  task_queue_tests.cpp
+//
+
+#include <cpp-utils/pool_allocator.h>
+#include <cpp-utils/task_queue.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace std::chrono_literals;
+using namespace yas;
+
+namespace yas::test {
+static task_future<int> schedule_and_submit(std::shared_ptr<task_queue<int>> const queue, std::vector<int> &called) {
+    called.push_back(1);
+
+    co_await queue->schedule(0);
+
+    called.push_back(2);
+
+    int const value = co_await queue->submit([](auto const &) { return 10; });
+
+    called.push_back(3);
+
+    co_return value + 1;
+}
+
+static task_future<void> schedule_with_canceller(std::shared_ptr<task_queue<int>> const queue,
+                                                 std::vector<int> &called) {
+    co_await queue->schedule({.canceller = 1});
+
+    called.push_back(1);
+}
+
+// holds the queue without retaining it, so that the queue can be released while the coroutine is suspended.
+static task_future<void> schedule_without_retaining(task_queue<int> *const queue) {
+    co_await queue->schedule(0);
+}
+}  // namespace yas::test
+
+YAS_TEST(task_queue, call_one_task) {
+    std::promise<void> executed_promise;
+    auto executed_future = executed_promise.get_future();
+
+    auto const queue = task_queue<int>::make_shared();
+    auto task = yas::task<int>::make_shared([&executed_promise](auto const &) { executed_promise.set_value(); });
+    queue->push_back(task);
+
+    YAS_TEST_ASSERT(executed_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+}
+
+YAS_TEST(task_queue, call_many_task) {
+    std::promise<void> executed_promise;
+    auto executed_future = executed_promise.get_future();
+
+    std::vector<int> called;
+
+    auto const queue = task_queue<int>::make_shared();
+
+    auto task_1 = task<int>::make_shared([&called](task<int> const &) {
+        called.push_back(1);
+    });
+    auto task_2 = task<int>::make_shared([&called](task<int> const &) {
+        called.push_back(2);
+    });
+    auto task_3 = task<int>::make_shared([&called, &executed_promise](task<int> const &) {
+        called.push_back(3);
+        executed_promise.set_value();
+    });
+
+    queue->push_back(task_1);
+    queue->push_back(task_2);
+    queue->push_back(task_3);
+
+    YAS_TEST_ASSERT(executed_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3}));
+}
+
+YAS_TEST(task_queue, suspend) {
+    std::promise<void> executed_promise;
+    auto executed_future = executed_promise.get_future();
+
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    bool called = false;
+
+    auto task = yas::task<int>::make_shared([&called, &executed_promise](auto const &) {
+        called = true;
+        executed_promise.set_value();
+    });
+
+    queue->push_back(task);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_FALSE(called);
+
+    queue->resume();
+
+    YAS_TEST_ASSERT(executed_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+
+    YAS_TEST_ASSERT(called);
+}
+
+YAS_TEST(task_queue, is_suspended) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    YAS_TEST_ASSERT(queue->is_suspended());
+
+    queue->resume();
+
+    YAS_TEST_ASSERT_FALSE(queue->is_suspended());
+}
+
+YAS_TEST(task_queue, insert_to_top) {
+    std::promise<void> executed_promise;
+    auto executed_future = executed_promise.get_future();
+
+    std::vector<int> called;
+
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    auto task_1 = task<int>::make_shared([&called](task<int> const &) {
+        called.push_back(1);
+    });
+    auto task_2 = task<int>::make_shared([&called](task<int> const &) {
+        called.push_back(2);
+    });
+    auto task_3 = task<int>::make_shared([&called, &executed_promise](task<int> const &) {
+        called.push_back(3);
+        executed_promise.set_value();
+    });
+
+    queue->push_back(task_3);
+    queue->push_front(task_2);
+    queue->push_front(task_1);
+
+    queue->resume();
+
+    YAS_TEST_ASSERT(executed_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3}));
+}
+
+YAS_TEST(task_queue, task_cancel) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    bool called = false;
+
+    auto task = yas::task<int>::make_shared([&called](auto const &) { called = true; });
+
+    queue->push_back(task);
+
+    task->cancel();
+
+    queue->resume();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_FALSE(called);
+}
+
+YAS_TEST(task_queue, cancel_task_from_queue) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    bool called = false;
+
+    auto task = yas::task<int>::make_shared([&called](auto const &) { called = true; });
+
+    queue->push_back(task);
+
+    queue->cancel(task);
+
+    queue->resume();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_FALSE(called);
+}
+
+YAS_TEST(task_queue, cancel_current_task) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    std::promise<void> start_promise;
+    std::promise<void> wait_promise;
+    std::promise<bool> end_promise;
+
+    auto start_future = start_promise.get_future();
+    auto wait_future = wait_promise.get_future();
+    auto end_future = end_promise.get_future();
+
+    auto task = yas::task<int>::make_shared([&start_promise, &wait_future, &end_promise](auto const &task) {
+        start_promise.set_value();
+        wait_future.get();
+        end_promise.set_value(task.is_canceled());
+    });
+
+    queue->push_back(task);
+    queue->resume();
+
+    start_future.get();
+
+    queue->cancel(task);
+
+    wait_promise.set_value();
+
+    YAS_TEST_ASSERT(end_future.get());
+}
+
+YAS_TEST(task_queue, cancel_with_cancellation) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    bool called = false;
+
+    auto task = yas::task<int>::make_shared([&called](auto const &) { called = true; }, {.canceller = 100});
+
+    queue->push_back(task);
+
+    queue->cancel([](auto const &task_canceller) { return task_canceller == 100; });
+
+    queue->resume();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_FALSE(called);
+}
+
+YAS_TEST(task_queue, cancel_with_cancellation_current_task) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    std::promise<void> start_promise;
+    std::promise<void> wait_promise;
+    std::promise<bool> end_promise;
+
+    auto start_future = start_promise.get_future();
+    auto wait_future = wait_promise.get_future();
+    auto end_future = end_promise.get_future();
+
+    auto task = yas::task<int>::make_shared(
+        [&start_promise, &wait_future, &end_promise](auto const &task) {
+            start_promise.set_value();
+            wait_future.get();
+            end_promise.set_value(task.is_canceled());
+        },
+        {.canceller = 200});
+
+    queue->push_back(task);
+    queue->resume();
+
+    start_future.get();
+
+    queue->cancel([](auto const &canceller) { return canceller == 200; });
+
+    wait_promise.set_value();
+
+    YAS_TEST_ASSERT(end_future.get());
+}
+
+YAS_TEST(task_queue, priority) {
+    std::promise<void> executed_promise;
+    auto executed_future = executed_promise.get_future();
+
+    std::vector<int> called;
+
+    auto queue = task_queue<int>::make_shared(3);
+
+    queue->suspend();
+
+    auto task_1a = task<int>::make_shared(
+        [&called](auto const &) {
+            called.push_back(0);
+        },
+        {.priority = 0});
+    auto task_1b = task<int>::make_shared(
+        [&called](auto const &) {
+            called.push_back(1);
+        },
+        {.priority = 0});
+    auto task_2a = task<int>::make_shared(
+        [&called](auto const &) {
+            called.push_back(2);
+        },
+        {.priority = 1});
+    auto task_2b = task<int>::make_shared(
+        [&called](auto const &) {
+            called.push_back(3);
+        },
+        {.priority = 1});
+    auto task_3a = task<int>::make_shared(
+        [&called](auto const &) {
+            called.push_back(4);
+        },
+        {.priority = 2});
+    auto task_3b = task<int>::make_shared(
+        [&called, &executed_promise](auto const &) {
+            called.push_back(5);
+            executed_promise.set_value();
+        },
+        {.priority = 2});
+
+    queue->push_back(task_3a);
+    queue->push_back(task_2a);
+    queue->push_back(task_1a);
+    queue->push_back(task_3b);
+    queue->push_back(task_2b);
+    queue->push_back(task_1b);
+
+    queue->resume();
+
+    YAS_TEST_ASSERT(executed_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2, 3, 4, 5}));
+}
+
+YAS_TEST(task_queue, wait) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    bool called = false;
+
+    auto task = yas::task<int>::make_shared([&called](auto const &) {
+        std::this_thread::sleep_for(100ms);
+
+        called = true;
+    });
+
+    queue->push_back(task);
+
+    queue->resume();
+
+    queue->wait_until_all_tasks_are_finished();
+
+    YAS_TEST_ASSERT(called);
+}
+
+YAS_TEST(task_queue, wait_failed) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    auto task = yas::task<int>::make_shared([](auto const &) {});
+
+    queue->push_back(task);
+
+    YAS_TEST_ASSERT_THROWS(queue->wait_until_all_tasks_are_finished());
+}
+
+YAS_TEST(task_queue, is_operating_by_current_task) {
+    auto const queue = task_queue<int>::make_shared(1);
+
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    auto task = yas::task<int>::make_shared([&future](auto const &) { future.get(); });
+    queue->push_back(task);
+
+    YAS_TEST_ASSERT(queue->is_operating());
+
+    promise.set_value();
+
+    queue->wait_until_all_tasks_are_finished();
+
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, is_operating_by_tasks) {
+    auto const queue = task_queue<int>::make_shared(1);
+
+    queue->suspend();
+
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    auto task = yas::task<int>::make_shared([&promise](auto const &) { promise.set_value(); });
+    queue->push_back(task);
+
+    YAS_TEST_ASSERT(queue->is_operating());
+
+    queue->resume();
+
+    future.get();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, executor) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    int called = 0;
+
+    queue->push_back(task<int>::make_shared([&called](auto const &) { ++called; }));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { ++called; }));
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+    YAS_TEST_ASSERT_EQUAL(called, 0);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, 1);
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, 2);
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, concurrency) {
+    auto const queue = task_queue<int>::make_shared(1, 2);
+
+    YAS_TEST_ASSERT_EQUAL(queue->concurrency(), 2);
+
+    std::promise<void> promise_1;
+    std::promise<void> promise_2;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+
+    queue->push_back(task<int>::make_shared([&promise_1, &future_2](auto const &) {
+        promise_1.set_value();
+        future_2.get();
+    }));
+    queue->push_back(task<int>::make_shared([&promise_2, &future_1](auto const &) {
+        future_1.get();
+        promise_2.set_value();
+    }));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, concurrency_priority_and_cancel) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, 2, executor);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(3); }, {.priority = 1}));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(1); }, {.priority = 0}));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(2); },
+                                            {.priority = 0, .canceller = 100}));
+
+    queue->resume();
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 2);
+
+    queue->cancel([](auto const &canceller) { return canceller == 100; });
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1}));
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1, 3}));
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, zero_concurrency) {
+    YAS_TEST_ASSERT_THROWS(task_queue<int>::make_shared(1, 0));
+}
+
+YAS_TEST(task_queue, wait_with_timeout) {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    queue->push_back(task<int>::make_shared([&future](auto const &) { future.get(); }));
+
+    YAS_TEST_ASSERT_FALSE(queue->wait_until_all_tasks_are_finished(10ms));
+
+    promise.set_value();
+
+    YAS_TEST_ASSERT(queue->wait_until_all_tasks_are_finished(1000ms));
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, wait_failed_by_suspending) {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    queue->push_back(task<int>::make_shared([&future](auto const &) { future.get(); }));
+
+    std::thread thread{[&queue] {
+        std::this_thread::sleep_for(10ms);
+        queue->suspend();
+    }};
+
+    YAS_TEST_ASSERT_THROWS(queue->wait_until_all_tasks_are_finished());
+
+    thread.join();
+    queue->resume();
+    promise.set_value();
+    queue->wait_until_all_tasks_are_finished();
+}
+
+YAS_TEST(task_queue, push_back_from_many_threads) {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::size_t const thread_count = 4;
+    std::size_t const task_count = 100;
+
+    std::atomic<std::size_t> count;
+    count = 0;
+    std::atomic<std::size_t> unordered_count = 0;
+    std::vector<std::size_t> last_indices(thread_count, 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        threads.emplace_back([&queue, &count, &unordered_count, &last_indices, thread_idx, task_count] {
+            for (std::size_t idx = 1; idx <= task_count; ++idx) {
+                queue->push_back(
+                    task<int>::make_shared([&count, &unordered_count, &last_indices, thread_idx, idx](auto const &) {
+                        if (last_indices.at(thread_idx) + 1 != idx) {
+                            ++unordered_count;
+                        }
+                        last_indices.at(thread_idx) = idx;
+                        ++count;
+                    }));
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    queue->wait_until_all_tasks_are_finished();
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), thread_count * task_count);
+    YAS_TEST_ASSERT_EQUAL(unordered_count.load(), 0);
+}
+
+YAS_TEST(task_queue, push_back_same_task_twice) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    int called = 0;
+
+    auto const task = yas::task<int>::make_shared([&called](auto const &) { ++called; });
+
+    queue->push_back(task);
+    queue->push_back(task);
+
+    queue->resume();
+
+    executor->process();
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, 2);
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, task_is_pooled) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->push_back(task<int>::make_shared([](auto const &) {}));
+    executor->process();
+
+    auto const &pool = pool_allocator<task<int>>::pool_t::shared();
+    std::size_t const heap_block_count = pool.heap_block_count();
+
+    for (int idx = 0; idx < 10; ++idx) {
+        queue->push_back(task<int>::make_shared([](auto const &) {}));
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(pool.heap_block_count(), heap_block_count);
+}
+
+YAS_TEST(task_queue, cancel_by_canceller) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    int called = 0;
+
+    auto const task_1 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 1});
+    auto const task_2 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 2});
+    auto const task_3 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 1});
+
+    queue->push_back(task_1);
+    queue->push_back(task_2);
+    queue->push_back(task_3);
+
+    queue->cancel_by_canceller(1);
+
+    YAS_TEST_ASSERT(task_1->is_canceled());
+    YAS_TEST_ASSERT_FALSE(task_2->is_canceled());
+    YAS_TEST_ASSERT(task_3->is_canceled());
+
+    queue->resume();
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, 1);
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, cancel_by_canceller_current_task) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    bool called = false;
+
+    auto const task = yas::task<int>::make_shared([&called](auto const &) { called = true; }, {.canceller = 300});
+
+    queue->push_back(task);
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    queue->cancel_by_canceller(300);
+
+    executor->process();
+
+    YAS_TEST_ASSERT(task->is_canceled());
+    YAS_TEST_ASSERT_FALSE(called);
+}
+
+YAS_TEST(task_queue, cancel_task_not_in_queue) {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    auto const queued_task = task<int>::make_shared([](auto const &) {});
+    auto const other_task = task<int>::make_shared([](auto const &) {});
+
+    queue->push_back(queued_task);
+
+    queue->cancel(other_task);
+
+    YAS_TEST_ASSERT_FALSE(other_task->is_canceled());
+    YAS_TEST_ASSERT_FALSE(queued_task->is_canceled());
+}
+
+YAS_TEST(task_queue, metrics) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, executor);
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    YAS_TEST_ASSERT_FALSE(queue->metrics());
+    YAS_TEST_ASSERT_THROWS(queue->set_metrics(task_queue_metrics::make_shared(1)));
+
+    queue->set_metrics(metrics);
+
+    YAS_TEST_ASSERT_EQUAL(queue->metrics(), metrics);
+
+    queue->suspend();
+
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 0}));
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 1, .canceller = 1}));
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 1}));
+
+    YAS_TEST_ASSERT_EQUAL(metrics->queue_depth(), 3);
+    YAS_TEST_ASSERT_EQUAL(metrics->max_queue_depth(), 3);
+
+    queue->cancel_by_canceller(1);
+
+    YAS_TEST_ASSERT_EQUAL(metrics->cancellation_count(), 1);
+
+    queue->resume();
+
+    executor->process();
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(metrics->queue_depth(), 0);
+    YAS_TEST_ASSERT_EQUAL(metrics->waiting(0).count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->execution(0).count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->waiting(1).count(), 1);
+    YAS_TEST_ASSERT_EQUAL(metrics->execution(1).count(), 1);
+}
+
+YAS_TEST(task_queue, metrics_cancellation_count) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const metrics = task_queue_metrics::make_shared(1);
+
+    queue->set_metrics(metrics);
+    queue->set_batch_size(2);
+    queue->suspend();
+
+    auto const canceled_task = task<int>::make_shared([](auto const &) {}, {.canceller = 1});
+    queue->push_back(canceled_task);
+    queue->push_back(task<int>::make_shared([](auto const &) {}));
+
+    queue->cancel(canceled_task);
+    queue->cancel(canceled_task);
+    queue->cancel_by_canceller(1);
+
+    YAS_TEST_ASSERT_EQUAL(metrics->cancellation_count(), 1);
+
+    queue->cancel_all();
+
+    YAS_TEST_ASSERT_EQUAL(metrics->cancellation_count(), 2);
+
+    // the finished task of a batch is not counted while the batch is executing.
+    auto const finished_task = task<int>::make_shared([](auto const &) {});
+    queue->push_back(finished_task);
+    queue->push_back(task<int>::make_shared([&queue, &finished_task](auto const &) {
+        queue->cancel(finished_task);
+        queue->cancel_all();
+    }));
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(metrics->cancellation_count(), 3);
+}
+
+YAS_TEST(task_queue, deadline) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const metrics = task_queue_metrics::make_shared(1);
+    auto const now = std::chrono::steady_clock::now();
+
+    queue->set_metrics(metrics);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const expired_task =
+        task<int>::make_shared([&called](auto const &) { called.push_back(1); }, {.deadline = now});
+    queue->push_back(expired_task);
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.push_back(2); },
+                                            {.deadline = now + std::chrono::seconds(10)}));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    queue->resume();
+
+    YAS_TEST_ASSERT(expired_task->is_canceled());
+    YAS_TEST_ASSERT_EQUAL(metrics->expiration_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{2}));
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, earliest_deadline_first) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const now = std::chrono::steady_clock::now();
+
+    YAS_TEST_ASSERT_EQUAL(queue->ordering(), task_queue_ordering::fifo);
+
+    queue->set_ordering(task_queue_ordering::earliest_deadline_first);
+
+    YAS_TEST_ASSERT_EQUAL(queue->ordering(), task_queue_ordering::earliest_deadline_first);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, std::optional<std::chrono::steady_clock::time_point> deadline) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.deadline = deadline});
+    };
+
+    queue->push_back(make_task(1, std::nullopt));
+    queue->push_back(make_task(2, now + std::chrono::seconds(30)));
+    queue->push_back(make_task(3, now + std::chrono::seconds(10)));
+    queue->push_back(make_task(4, now + std::chrono::seconds(20)));
+    queue->push_back(make_task(5, now + std::chrono::seconds(10)));
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{3, 5, 4, 2, 1}));
+}
+
+YAS_TEST(task_queue, coalescing) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, int const canceller) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.canceller = canceller, .coalescing = true});
+    };
+
+    auto const current_task = make_task(0, 1);
+    queue->push_back(current_task);
+
+    auto const task1 = make_task(1, 1);
+    auto const task2 = make_task(2, 2);
+    auto const task3 = make_task(3, 1);
+
+    queue->push_back(task1);
+    queue->push_back(task2);
+    queue->push_back(task3);
+
+    YAS_TEST_ASSERT_FALSE(current_task->is_canceled());
+    YAS_TEST_ASSERT(task1->is_canceled());
+    YAS_TEST_ASSERT_FALSE(task2->is_canceled());
+    YAS_TEST_ASSERT_FALSE(task3->is_canceled());
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{0, 2, 3}));
+}
+
+YAS_TEST(task_queue, coalescing_with_capacity) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::reject);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, int const canceller) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.canceller = canceller, .coalescing = true});
+    };
+
+    auto const task1 = make_task(1, 1);
+
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(task1), task_push_result::pushed);
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(2, 2)), task_push_result::pushed);
+
+    // the replaced task releases its room.
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(3, 1)), task_push_result::pushed);
+    YAS_TEST_ASSERT(task1->is_canceled());
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(4, 3)), task_push_result::rejected);
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{2, 3}));
+}
+
+YAS_TEST(task_queue, batch) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, 2, executor);
+
+    YAS_TEST_ASSERT_EQUAL(queue->batch_size(), 1);
+    YAS_TEST_ASSERT_THROWS(queue->set_batch_size(0));
+
+    queue->set_batch_size(3);
+
+    YAS_TEST_ASSERT_EQUAL(queue->batch_size(), 3);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    for (int idx = 0; idx < 5; ++idx) {
+        queue->push_back(task<int>::make_shared([&called, idx](auto const &) { called.push_back(idx); }));
+    }
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.push_back(10); }, {.priority = 1}));
+
+    queue->resume();
+
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 2);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{0, 1, 2, 3, 4}));
+    YAS_TEST_ASSERT_EQUAL(executor->execution_count(), 1);
+
+    executor->process();
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{0, 1, 2, 3, 4, 10}));
+    YAS_TEST_ASSERT_FALSE(queue->is_operating());
+}
+
+YAS_TEST(task_queue, submit) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    auto const value_future = queue->submit([](auto const &) { return 1; });
+    auto const void_future = queue->submit([](auto const &) {});
+    auto const failed_future = queue->submit([](auto const &) -> int { throw std::logic_error("test"); });
+    auto const canceled_future = queue->submit([](auto const &) { return 2; }, {.canceller = 1});
+
+    queue->cancel_by_canceller(1);
+
+    YAS_TEST_ASSERT_EQUAL(value_future.status(), task_future_status::pending);
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(value_future.get(), 1);
+    YAS_TEST_ASSERT_EQUAL(void_future.status(), task_future_status::completed);
+    YAS_TEST_ASSERT_EQUAL(failed_future.status(), task_future_status::failed);
+    YAS_TEST_ASSERT_EQUAL(canceled_future.status(), task_future_status::canceled);
+}
+
+YAS_TEST(task_queue, schedule) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    std::vector<int> called;
+
+    auto const future = test::schedule_and_submit(queue, called);
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1}));
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1, 2, 3}));
+    YAS_TEST_ASSERT_EQUAL(future.get(), 11);
+
+    YAS_TEST_ASSERT_THROWS((void)queue->schedule(1));
+}
+
+YAS_TEST(task_queue, schedule_canceled) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const future = test::schedule_with_canceller(queue, called);
+
+    queue->cancel_by_canceller(1);
+    queue->cancel_all();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called.size(), 0);
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::canceled);
+}
+
+YAS_TEST(task_queue, schedule_canceled_by_releasing_queue) {
+    auto queue = task_queue<int>::make_shared();
+
+    std::promise<void> started_promise;
+    std::promise<void> gate_promise;
+    auto started_future = started_promise.get_future();
+    auto gate_future = gate_promise.get_future().share();
+
+    queue->push_back(task<int>::make_shared([&started_promise, gate_future](auto const &) {
+        started_promise.set_value();
+        gate_future.wait();
+    }));
+
+    started_future.get();
+
+    auto const future = test::schedule_without_retaining(queue.get());
+
+    YAS_TEST_ASSERT_FALSE(future.is_ready());
+
+    // the executing task retains the queue, so the queue and its executor are released on the executor thread after
+    // the coroutine is canceled.
+    queue = nullptr;
+    gate_promise.set_value();
+
+    YAS_TEST_ASSERT(future.wait_for(1000ms));
+    YAS_TEST_ASSERT_EQUAL(future.status(), task_future_status::canceled);
+}
+
+YAS_TEST(task_queue, capacity_reject) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, executor);
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    queue->set_metrics(metrics);
+
+    YAS_TEST_ASSERT_FALSE(queue->capacity(0).has_value());
+    YAS_TEST_ASSERT_EQUAL(queue->overflow_policy(0), task_queue_overflow_policy::block);
+    YAS_TEST_ASSERT_THROWS(queue->set_capacity(0, 0));
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::reject);
+
+    YAS_TEST_ASSERT_EQUAL(queue->capacity(0), 2);
+    YAS_TEST_ASSERT_EQUAL(queue->overflow_policy(0), task_queue_overflow_policy::reject);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, task_priority_t const priority) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.priority = priority});
+    };
+
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(1, 0)), task_push_result::pushed);
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(2, 0)), task_push_result::pushed);
+
+    auto const rejected_task = make_task(3, 0);
+
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(rejected_task), task_push_result::rejected);
+    YAS_TEST_ASSERT_FALSE(rejected_task->is_canceled());
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(10, 1)), task_push_result::pushed);
+    YAS_TEST_ASSERT_EQUAL(metrics->overflow_count(), 1);
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{1, 2, 10}));
+}
+
+YAS_TEST(task_queue, capacity_drop) {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::drop_oldest);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); });
+    };
+
+    auto const oldest_task = make_task(1);
+
+    queue->push_back(oldest_task);
+    queue->push_back(make_task(2));
+
+    YAS_TEST_ASSERT_EQUAL(queue->push_back(make_task(3)), task_push_result::dropped_oldest);
+    YAS_TEST_ASSERT(oldest_task->is_canceled());
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::drop_newest);
+
+    auto const newest_task = make_task(4);
+
+    YAS_TEST_ASSERT_EQUAL(queue->push_front(newest_task), task_push_result::dropped_newest);
+    YAS_TEST_ASSERT(newest_task->is_canceled());
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(called, (std::vector<int>{2, 3}));
+}
+
+YAS_TEST(task_queue, capacity_block) {
+    auto const queue = task_queue<int>::make_shared(1, 1);
+
+    queue->set_capacity(0, 1);
+
+    std::promise<void> gate_promise;
+    auto gate_future = gate_promise.get_future().share();
+    std::atomic<int> count = 0;
+
+    queue->push_back(task<int>::make_shared([gate_future](auto const &) { gate_future.wait(); }));
+
+    std::this_thread::sleep_for(10ms);
+
+    queue->push_back(task<int>::make_shared([&count](auto const &) { ++count; }));
+
+    YAS_TEST_ASSERT_EQUAL(queue->try_push(task<int>::make_shared([&count](auto const &) { ++count; })),
+                          task_push_result::rejected);
+
+    std::atomic<bool> is_pushed = false;
+
+    std::thread thread{[&queue, &count, &is_pushed] {
+        queue->push_back(task<int>::make_shared([&count](auto const &) { ++count; }));
+        is_pushed = true;
+    }};
+
+    std::this_thread::sleep_for(10ms);
+
+    YAS_TEST_ASSERT_FALSE(is_pushed);
+
+    gate_promise.set_value();
+    thread.join();
+
+    queue->wait_until_all_tasks_are_finished();
+
+    YAS_TEST_ASSERT(is_pushed);
+    YAS_TEST_ASSERT_EQUAL(count, 2);
+}
+
+YAS_TEST(task_queue, capacity_on_concurrent_producers) {
+    std::size_t const thread_count = 4;
+    std::size_t const task_count = 100;
+    std::size_t const capacity = 4;
+
+    for (auto const policy : {task_queue_overflow_policy::reject, task_queue_overflow_policy::drop_oldest}) {
+        auto const queue = task_queue<int>::make_shared(1, 1);
+
+        queue->set_capacity(0, capacity, policy);
+        queue->suspend();
+
+        auto const count = std::make_shared<std::atomic<std::size_t>>(0);
+        std::atomic<std::size_t> pushed_count = 0;
+        std::vector<std::thread> threads;
+
+        for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+            threads.emplace_back([&queue, &pushed_count, count] {
+                for (std::size_t idx = 0; idx < task_count; ++idx) {
+                    auto const result = queue->push_back(task<int>::make_shared([count](auto const &) { ++*count; }));
+                    if (result == task_push_result::pushed) {
+                        ++pushed_count;
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        queue->resume();
+        queue->wait_until_all_tasks_are_finished();
+
+        if (policy == task_queue_overflow_policy::reject) {
+            YAS_TEST_ASSERT_EQUAL(pushed_count, capacity);
+        }
+        YAS_TEST_ASSERT_EQUAL(*count, capacity);
+    }
+}
+
+YAS_TEST(task_queue, no_allocation_in_steady_state) {
+    std::size_t const thread_count = 4;
+    std::size_t const task_count = 100;
+
+    auto const queue = task_queue<int>::make_shared(2, thread_count);
+
+    std::atomic<std::size_t> count = 0;
+
+    auto const push = [&queue, &count](std::size_t const idx) {
+        queue->push_back(task<int>::make_shared(
+            [&count](auto const &) { ++count; },
+            {.priority = static_cast<task_priority_t>(idx % 2), .canceller = static_cast<int>(idx)}));
+    };
+
+    // all of the tasks exist at once on a suspended queue. the pools also keep up to the cache capacity on each thread.
+    std::size_t const warming_count = task_count + pool_allocator<int>::pool_t::cache_capacity * (thread_count + 1);
+
+    queue->suspend();
+    for (std::size_t idx = 0; idx < warming_count; ++idx) {
+        push(idx);
+    }
+    queue->resume();
+    queue->wait_until_all_tasks_are_finished();
+
+    std::size_t const allocation_count = test::heap_allocation_count();
+
+    // the tasks are indexed and unindexed on the threads of the executor as well as on this thread.
+    for (std::size_t cycle = 0; cycle < 200; ++cycle) {
+        for (std::size_t idx = 0; idx < task_count; ++idx) {
+            push(idx);
+        }
+        queue->wait_until_all_tasks_are_finished();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(test::heap_allocation_count(), allocation_count);
+    YAS_TEST_ASSERT_EQUAL(count.load(), warming_count + task_count * 200);
+}
@@ -0,0 +1,78 @@
+//
+//  test.h
+//
+
+#pragma once
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// a minimal replacement of XCTest to run the portable tests where XCTest is not available.
+
+namespace yas::test {
+struct test_case {
+    char const *suite;
+    char const *name;
+    void (*function)();
+};
+
+struct failure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+std::vector<test_case> &test_cases();
+
+// the number of allocations by the global operator new, which is replaced by cpp-utils-allocation-counter.
+std::size_t heap_allocation_count();
+
+struct registration {
+    registration(char const *suite, char const *name, void (*function)()) {
+        test_cases().push_back({suite, name, function});
+    }
+};
+
+[[noreturn]] inline void fail(char const *file, int const line, std::string const &message) {
+    std::ostringstream stream;
+    stream << file << ":" << line << ": " << message;
+    throw failure(stream.str());
+}
+}  // namespace yas::test
+
+#define YAS_TEST(suite, name)                                                                               \
+    static void yas_test_##suite##_##name();                                                                \
+    static yas::test::registration const yas_test_registration_##suite##_##name{#suite, #name,              \
+                                                                                yas_test_##suite##_##name}; \
+    static void yas_test_##suite##_##name()
+
+#define YAS_TEST_ASSERT(expr)                                                \
+    do {                                                                     \
+        if (!(expr)) {                                                       \
+            yas::test::fail(__FILE__, __LINE__, "assertion failed: " #expr); \
+        }                                                                    \
+    } while (0)
+
+#define YAS_TEST_ASSERT_FALSE(expr) YAS_TEST_ASSERT(!(expr))
+
+#define YAS_TEST_ASSERT_EQUAL(lhs, rhs)                                                 \
+    do {                                                                                \
+        if (!((lhs) == (rhs))) {                                                        \
+            yas::test::fail(__FILE__, __LINE__, "assertion failed: " #lhs " == " #rhs); \
+        }                                                                               \
+    } while (0)
+
+#define YAS_TEST_ASSERT_THROWS(expr)                                              \
+    do {                                                                          \
+        bool yas_test_is_thrown = false;                                          \
+        try {                                                                     \
+            (void)(expr);                                                         \
+        } catch (yas::test::failure const &) {                                    \
+            throw;                                                                \
+        } catch (...) {                                                           \
+            yas_test_is_thrown = true;                                            \
+        }                                                                         \
+        if (!yas_test_is_thrown) {                                                \
+            yas::test::fail(__FILE__, __LINE__, "expected an exception: " #expr); \
+        }                                                                         \
+    } while (0)
@@ -0,0 +1,101 @@
+//
+//  thread_tests.cpp
+//
+
+#include <cpp-utils/thread.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(thread, is_main) {
+    YAS_TEST_ASSERT(thread::is_main());
+
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+
+    std::thread{[&promise] { promise.set_value(thread::is_main()); }}.join();
+
+    YAS_TEST_ASSERT_FALSE(future.get());
+}
+
+YAS_TEST(thread, sleep_for_timeinterval) {
+    auto const begin = std::chrono::steady_clock::now();
+
+    thread::sleep_for_timeinterval(0.1);
+
+    YAS_TEST_ASSERT(std::chrono::steady_clock::now() - begin >= std::chrono::milliseconds(100));
+}
+
+YAS_TEST(thread, perform_async_on_main_from_main) {
+    bool is_called = false;
+
+    thread::perform_async_on_main([&is_called] {
+        YAS_TEST_ASSERT(thread::is_main());
+        is_called = true;
+    });
+
+    YAS_TEST_ASSERT_FALSE(is_called);
+
+    thread::process_main_queue();
+
+    YAS_TEST_ASSERT(is_called);
+}
+
+YAS_TEST(thread, perform_async_on_main_from_bg) {
+    std::atomic<bool> is_main = false;
+
+    std::thread{[&is_main] { thread::perform_async_on_main([&is_main] { is_main = thread::is_main(); }); }}.join();
+
+    thread::process_main_queue();
+
+    YAS_TEST_ASSERT(is_main);
+}
+
+YAS_TEST(thread, perform_sync_on_main) {
+    std::atomic<bool> is_main = false;
+    std::atomic<bool> is_finished = false;
+
+    std::thread bg_thread{[&is_main, &is_finished] {
+        thread::perform_sync_on_main([&is_main] { is_main = thread::is_main(); });
+        is_finished = true;
+    }};
+
+    while (!is_finished) {
+        thread::process_main_queue();
+        std::this_thread::yield();
+    }
+
+    bg_thread.join();
+
+    YAS_TEST_ASSERT(is_main);
+}
+
+YAS_TEST(thread, perform_sync_on_main_throwing) {
+    std::atomic<bool> is_thrown = false;
+    std::atomic<bool> is_finished = false;
+
+    std::thread bg_thread{[&is_thrown, &is_finished] {
+        try {
+            thread::perform_sync_on_main([] { throw std::runtime_error("handler thrown"); });
+        } catch (std::runtime_error const &) {
+            is_thrown = true;
+        }
+        is_finished = true;
+    }};
+
+    while (!is_finished) {
+        thread::process_main_queue();
+        std::this_thread::yield();
+    }
+
+    bg_thread.join();
+
+    YAS_TEST_ASSERT(is_thrown);
+}
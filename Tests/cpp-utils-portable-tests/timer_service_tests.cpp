@@ -0,0 +1,136 @@
+//
+//  timer_service_tests.cpp
+//
+
+#include <cpp-utils/timer_service.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+using namespace std::chrono_literals;
+
+YAS_TEST(timer_service, schedule) {
+    auto const service = timer_service::make_shared();
+
+    std::promise<bool> promise;
+    auto const begin = std::chrono::steady_clock::now();
+
+    service->schedule(10ms, [&promise, &service] { promise.set_value(service->is_service_thread()); });
+
+    YAS_TEST_ASSERT_EQUAL(service->timer_count(), 1);
+
+    auto future = promise.get_future();
+    YAS_TEST_ASSERT(future.wait_for(10s) == std::future_status::ready);
+    YAS_TEST_ASSERT(future.get());
+    YAS_TEST_ASSERT(std::chrono::steady_clock::now() - begin >= 10ms);
+    YAS_TEST_ASSERT_FALSE(service->is_service_thread());
+}
+
+YAS_TEST(timer_service, order) {
+    auto const service = timer_service::make_shared();
+
+    std::vector<int> called;
+    std::promise<void> promise;
+
+    service->schedule(30ms, [&called, &promise] {
+        called.push_back(3);
+        promise.set_value();
+    });
+    service->schedule(10ms, [&called] { called.push_back(1); });
+    service->schedule(20ms, [&called] { called.push_back(2); });
+
+    YAS_TEST_ASSERT(promise.get_future().wait_for(10s) == std::future_status::ready);
+    YAS_TEST_ASSERT((called == std::vector<int>{1, 2, 3}));
+    YAS_TEST_ASSERT_EQUAL(service->timer_count(), 0);
+}
+
+YAS_TEST(timer_service, cancel) {
+    auto const service = timer_service::make_shared();
+
+    std::atomic<int> count = 0;
+
+    auto const timer_id = service->schedule(20ms, [&count] { ++count; });
+
+    YAS_TEST_ASSERT(service->cancel(timer_id));
+    YAS_TEST_ASSERT_FALSE(service->cancel(timer_id));
+    YAS_TEST_ASSERT_EQUAL(service->timer_count(), 0);
+
+    std::this_thread::sleep_for(50ms);
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), 0);
+}
+
+YAS_TEST(timer_service, repeating) {
+    auto const service = timer_service::make_shared();
+
+    std::atomic<int> count = 0;
+    timer_id self_id;
+    std::promise<bool> promise;
+
+    self_id = service->schedule_repeating(5ms, [&count, &service, &self_id, &promise] {
+        if (++count == 3) {
+            promise.set_value(service->cancel(self_id));
+        }
+    });
+
+    auto future = promise.get_future();
+    YAS_TEST_ASSERT(future.wait_for(10s) == std::future_status::ready);
+    YAS_TEST_ASSERT(future.get());
+
+    std::this_thread::sleep_for(30ms);
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), 3);
+    YAS_TEST_ASSERT_EQUAL(service->timer_count(), 0);
+    YAS_TEST_ASSERT_THROWS(service->schedule_repeating(0us, [] {}));
+}
+
+YAS_TEST(timer_service, cancel_waits_for_handler) {
+    auto const service = timer_service::make_shared();
+
+    std::promise<void> started;
+    std::atomic<bool> is_finished = false;
+
+    auto const timer_id = service->schedule(0us, [&started, &is_finished] {
+        started.set_value();
+        std::this_thread::sleep_for(50ms);
+        is_finished = true;
+    });
+
+    started.get_future().wait();
+
+    // the timer firing once is already finished.
+    YAS_TEST_ASSERT_FALSE(service->cancel(timer_id));
+    YAS_TEST_ASSERT(is_finished);
+}
+
+YAS_TEST(timer_service, many_timers) {
+    auto const service = timer_service::make_shared();
+
+    std::size_t const timer_count = 100000;
+    std::atomic<std::size_t> fired_count = 0;
+    std::vector<timer_id> timer_ids;
+    timer_ids.reserve(timer_count);
+
+    for (std::size_t idx = 0; idx < timer_count; ++idx) {
+        timer_ids.push_back(service->schedule(std::chrono::microseconds(idx % 20000), [&fired_count] { ++fired_count; }));
+    }
+
+    std::size_t canceled_count = 0;
+    for (std::size_t idx = 0; idx < timer_count; idx += 2) {
+        if (service->cancel(timer_ids.at(idx))) {
+            ++canceled_count;
+        }
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + 10s;
+    while (service->timer_count() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    YAS_TEST_ASSERT_EQUAL(service->timer_count(), 0);
+    YAS_TEST_ASSERT_EQUAL(fired_count.load() + canceled_count, timer_count);
+}
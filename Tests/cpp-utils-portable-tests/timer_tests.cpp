@@ -0,0 +1,132 @@
+//
+//  timer_tests.cpp
+//
+
+#include <cpp-utils/thread.h>
+#include <cpp-utils/timer.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(timer, no_repeats) {
+    std::atomic<int> count = 0;
+    std::promise<void> promise;
+
+    auto timer = yas::timer(0.05, false, [&count, &promise] {
+        if (++count == 1) {
+            promise.set_value();
+        }
+    });
+
+    YAS_TEST_ASSERT(promise.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), 1);
+}
+
+YAS_TEST(timer, repeats) {
+    std::atomic<int> count = 0;
+    std::promise<void> promise;
+
+    auto timer = yas::timer(0.02, true, [&count, &promise] {
+        if (++count == 2) {
+            promise.set_value();
+        }
+    });
+
+    YAS_TEST_ASSERT(promise.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+}
+
+YAS_TEST(timer, invalidate) {
+    std::atomic<int> count = 0;
+
+    auto timer = yas::timer(0.02, true, [&count] { ++count; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    timer.invalidate();
+    int const invalidated_count = count;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), invalidated_count);
+    YAS_TEST_ASSERT(invalidated_count > 1);
+}
+
+YAS_TEST(timer, invalidate_at_destructor) {
+    std::atomic<int> count = 0;
+
+    {
+        auto timer = yas::timer(0.02, true, [&count] { ++count; });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    int const invalidated_count = count;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    YAS_TEST_ASSERT_EQUAL(count.load(), invalidated_count);
+    YAS_TEST_ASSERT(invalidated_count > 1);
+}
+
+YAS_TEST(timer, default_delivery) {
+    YAS_TEST_ASSERT_EQUAL(timer::default_delivery, timer_delivery::service);
+}
+
+YAS_TEST(timer, main_delivery) {
+    int count = 0;
+    bool is_main = false;
+
+    auto timer = yas::timer(
+        0.02, false,
+        [&count, &is_main] {
+            ++count;
+            is_main = thread::is_main();
+        },
+        timer_delivery::main);
+
+    auto const limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (count == 0 && std::chrono::steady_clock::now() < limit) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        thread::process_main_queue();
+    }
+
+    YAS_TEST_ASSERT_EQUAL(count, 1);
+    YAS_TEST_ASSERT(is_main);
+}
+
+YAS_TEST(timer, invalidate_main_delivery_after_posted) {
+    int count = 0;
+
+    auto timer = yas::timer(0.01, true, [&count] { ++count; }, timer_delivery::main);
+
+    // the handler has been posted to the main thread and is waiting to be called.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    timer.invalidate();
+
+    thread::process_main_queue();
+
+    YAS_TEST_ASSERT_EQUAL(count, 0);
+}
+
+YAS_TEST(timer, skip_fires_while_main_delivery_is_waiting) {
+    int count = 0;
+
+    auto timer = yas::timer(0.01, true, [&count] { ++count; }, timer_delivery::main);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    thread::process_main_queue();
+
+    YAS_TEST_ASSERT_EQUAL(count, 1);
+}
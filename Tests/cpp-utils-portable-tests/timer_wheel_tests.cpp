@@ -0,0 +1,137 @@
+//
+//  timer_wheel_tests.cpp
+//
+
+#include <cpp-utils/timer_wheel.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(timer_wheel, advance) {
+    timer_wheel wheel;
+
+    wheel.insert(1, 300);
+    wheel.insert(2, 5);
+    wheel.insert(3, 70000);
+
+    YAS_TEST_ASSERT_EQUAL(wheel.size(), 3);
+    YAS_TEST_ASSERT_EQUAL(wheel.next_deadline().value(), 5);
+
+    std::vector<timer_wheel::index_t> expired;
+
+    wheel.advance(4, expired);
+
+    YAS_TEST_ASSERT(expired.empty());
+    YAS_TEST_ASSERT_EQUAL(wheel.elapsed(), 4);
+
+    wheel.advance(1000000, expired);
+
+    YAS_TEST_ASSERT((expired == std::vector<timer_wheel::index_t>{2, 1, 3}));
+    YAS_TEST_ASSERT_EQUAL(wheel.size(), 0);
+    YAS_TEST_ASSERT_FALSE(wheel.next_deadline().has_value());
+}
+
+YAS_TEST(timer_wheel, remove) {
+    timer_wheel wheel;
+
+    wheel.insert(0, 10);
+    wheel.insert(1, 10);
+
+    YAS_TEST_ASSERT(wheel.remove(0));
+    YAS_TEST_ASSERT_FALSE(wheel.remove(0));
+    YAS_TEST_ASSERT_FALSE(wheel.remove(100));
+    YAS_TEST_ASSERT_FALSE(wheel.contains(0));
+    YAS_TEST_ASSERT(wheel.contains(1));
+
+    std::vector<timer_wheel::index_t> expired;
+    wheel.advance(10, expired);
+
+    YAS_TEST_ASSERT((expired == std::vector<timer_wheel::index_t>{1}));
+}
+
+YAS_TEST(timer_wheel, insert_elapsed) {
+    timer_wheel wheel;
+
+    std::vector<timer_wheel::index_t> expired;
+    wheel.advance(100, expired);
+
+    wheel.insert(0, 50);
+
+    YAS_TEST_ASSERT_EQUAL(wheel.next_deadline().value(), 100);
+
+    wheel.advance(100, expired);
+
+    YAS_TEST_ASSERT((expired == std::vector<timer_wheel::index_t>{0}));
+}
+
+YAS_TEST(timer_wheel, distant_deadline) {
+    timer_wheel wheel;
+
+    timer_wheel::tick_t const distant = (timer_wheel::tick_t{1} << 52) + 12345;
+
+    wheel.insert(0, distant);
+    wheel.insert(1, 1000);
+
+    std::vector<timer_wheel::index_t> expired;
+
+    wheel.advance(distant - 1, expired);
+
+    YAS_TEST_ASSERT((expired == std::vector<timer_wheel::index_t>{1}));
+
+    wheel.advance(distant, expired);
+
+    YAS_TEST_ASSERT((expired == std::vector<timer_wheel::index_t>{1, 0}));
+}
+
+YAS_TEST(timer_wheel, random) {
+    std::mt19937_64 engine{0};
+    timer_wheel wheel;
+    std::map<timer_wheel::index_t, timer_wheel::tick_t> deadlines;
+    timer_wheel::tick_t now = 0;
+
+    auto const random_delay = [&engine] {
+        timer_wheel::tick_t const ranges[] = {10, 1000, 100000, 100000000, timer_wheel::tick_t{1} << 55};
+        return engine() % ranges[engine() % std::size(ranges)];
+    };
+
+    for (std::size_t step = 0; step < 100000; ++step) {
+        auto const op = engine() % 10;
+
+        if (op < 5) {
+            auto const idx = static_cast<timer_wheel::index_t>(engine() % 500);
+            auto const deadline = now + random_delay();
+            wheel.insert(idx, deadline);
+            deadlines.insert_or_assign(idx, deadline);
+        } else if (op < 7) {
+            auto const idx = static_cast<timer_wheel::index_t>(engine() % 500);
+            YAS_TEST_ASSERT_EQUAL(wheel.remove(idx), deadlines.erase(idx) > 0);
+        } else {
+            auto const next_deadline = wheel.next_deadline();
+            auto const to = (engine() % 3 == 0 && next_deadline) ? *next_deadline : now + random_delay() / 1000;
+
+            std::vector<timer_wheel::index_t> expired;
+            wheel.advance(to, expired);
+
+            std::vector<timer_wheel::index_t> expected;
+            std::erase_if(deadlines, [&expected, &to](auto const &pair) {
+                if (pair.second <= to) {
+                    expected.push_back(pair.first);
+                    return true;
+                }
+                return false;
+            });
+
+            std::sort(expired.begin(), expired.end());
+            YAS_TEST_ASSERT(expired == expected);
+
+            now = to;
+        }
+
+        YAS_TEST_ASSERT_EQUAL(wheel.size(), deadlines.size());
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  worker_tests.cpp
+//
+
+#include <cpp-utils/worker.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "test.h"
+
+using namespace yas;
+
+YAS_TEST(worker, processed) {
+    auto const worker = worker::make_shared();
+
+    std::promise<void> promise;
+    std::vector<int> called;
+
+    worker->add_task(0, [&called, count = 0]() mutable {
+        if (count < 2) {
+            called.push_back(count++);
+            return worker::task_result::processed;
+        }
+        return worker::task_result::unprocessed;
+    });
+
+    worker->add_task(1, [&called, &promise, is_called = false]() mutable {
+        if (!is_called) {
+            is_called = true;
+            called.push_back(10);
+            promise.set_value();
+        }
+        return worker::task_result::completed;
+    });
+
+    worker->start();
+
+    YAS_TEST_ASSERT(promise.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+
+    worker->stop();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 10}));
+}
+
+YAS_TEST(worker, insert_task_while_running) {
+    auto const worker = worker::make_shared(std::chrono::seconds(10));
+
+    worker->add_task(0, [] { return worker::task_result::unprocessed; });
+
+    worker->start();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->insert_task(1, [&promise] {
+        promise.set_value();
+        return worker::task_result::completed;
+    });
+
+    YAS_TEST_ASSERT(future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+
+    worker->stop();
+}
+
+YAS_TEST(worker, insert_and_remove_tasks_on_threads) {
+    auto const worker = worker::make_shared(std::chrono::milliseconds(1));
+
+    worker->add_task(0, [] { return worker::task_result::unprocessed; });
+
+    worker->start();
+
+    std::size_t constexpr thread_count = 4;
+    std::size_t constexpr task_count = 50;
+
+    auto const called_count = std::make_shared<std::atomic<std::size_t>>(0);
+    std::vector<std::thread> threads;
+
+    for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        threads.emplace_back([&worker, called_count] {
+            for (std::size_t idx = 0; idx < task_count; ++idx) {
+                auto const removed_id = worker->insert_task(1, [] { return worker::task_result::unprocessed; });
+
+                worker->insert_task(2, [called_count] {
+                    ++*called_count;
+                    return worker::task_result::completed;
+                });
+
+                worker->remove_task(removed_id);
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto const begin = std::chrono::steady_clock::now();
+    while (*called_count < thread_count * task_count &&
+           std::chrono::steady_clock::now() - begin < std::chrono::seconds(10)) {
+        std::this_thread::yield();
+    }
+
+    worker->stop();
+
+    YAS_TEST_ASSERT_EQUAL(*called_count, thread_count * task_count);
+}
+
+YAS_TEST(worker, stub_all_unprocessed) {
+    auto const worker = worker_stub::make_shared();
+
+    std::vector<int> called;
+
+    for (uint32_t order : {1, 2, 0}) {
+        worker->add_task(order, [&called, order] {
+            called.push_back(static_cast<int>(order));
+            return worker::task_result::unprocessed;
+        });
+    }
+
+    worker->start();
+
+    worker->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2}));
+
+    worker->process();
+
+    YAS_TEST_ASSERT((called == std::vector<int>{0, 1, 2, 0, 1, 2}));
+    YAS_TEST_ASSERT_EQUAL(worker->resource_tasks().size(), 3);
+}
@@ -0,0 +1,96 @@
+//
+//  executor_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/executor.h>
+#import <atomic>
+#import <future>
+#import <thread>
+
+using namespace yas;
+
+@interface executor_tests : XCTestCase
+
+@end
+
+@implementation executor_tests
+
+- (void)test_thread_pool_execute {
+    XCTestExpectation *exe_ex = [self expectationWithDescription:@"call execution"];
+
+    auto const executor = thread_pool_executor::make_shared();
+
+    executor->execute([exe_ex] { [exe_ex fulfill]; });
+
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+}
+
+- (void)test_thread_pool_reuses_thread {
+    auto const executor = thread_pool_executor::make_shared(1);
+
+    std::promise<std::thread::id> promise_1;
+    std::promise<std::thread::id> promise_2;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+
+    executor->execute([&promise_1] { promise_1.set_value(std::this_thread::get_id()); });
+    executor->execute([&promise_2] { promise_2.set_value(std::this_thread::get_id()); });
+
+    XCTAssertEqual(future_1.get(), future_2.get());
+}
+
+- (void)test_thread_pool_thread_count {
+    XCTAssertEqual(thread_pool_executor::make_shared()->thread_count(), 1);
+    XCTAssertEqual(thread_pool_executor::make_shared(4)->thread_count(), 4);
+    XCTAssertThrows(thread_pool_executor::make_shared(0));
+}
+
+- (void)test_thread_pool_concurrent {
+    auto const executor = thread_pool_executor::make_shared(2);
+
+    std::promise<void> promise_1;
+    std::promise<void> promise_2;
+    std::promise<void> end_promise;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+    auto end_future = end_promise.get_future();
+
+    executor->execute([&promise_1, &future_2, &end_promise] {
+        promise_1.set_value();
+        future_2.get();
+        end_promise.set_value();
+    });
+    executor->execute([&promise_2, &future_1] {
+        future_1.get();
+        promise_2.set_value();
+    });
+
+    XCTAssertEqual(end_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
+
+- (void)test_stub {
+    auto const executor = executor_stub::make_shared();
+
+    int called = 0;
+
+    executor->execute([&called, &executor] {
+        ++called;
+        executor->execute([&called] { ++called; });
+    });
+
+    XCTAssertEqual(executor->execution_count(), 1);
+    XCTAssertEqual(called, 0);
+
+    executor->process();
+
+    XCTAssertEqual(executor->execution_count(), 1);
+    XCTAssertEqual(called, 1);
+
+    executor->process();
+
+    XCTAssertEqual(executor->execution_count(), 0);
+    XCTAssertEqual(called, 2);
+}
+
+@end
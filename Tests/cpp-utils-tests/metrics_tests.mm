@@ -0,0 +1,90 @@
+//
+//  metrics_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/metrics.h>
+
+using namespace yas;
+
+@interface metrics_tests : XCTestCase
+
+@end
+
+@implementation metrics_tests
+
+- (void)test_bucket_index {
+    XCTAssertEqual(duration_histogram::bucket_index(std::chrono::nanoseconds(0)), 0);
+    XCTAssertEqual(duration_histogram::bucket_index(std::chrono::nanoseconds(1)), 1);
+    XCTAssertEqual(duration_histogram::bucket_index(std::chrono::nanoseconds(3)), 2);
+    XCTAssertEqual(duration_histogram::bucket_index(std::chrono::nanoseconds(4)), 3);
+    XCTAssertEqual(duration_histogram::bucket_index(std::chrono::hours(100)), duration_histogram::bucket_count - 1);
+
+    XCTAssertEqual(duration_histogram::bucket_upper_bound(2), std::chrono::nanoseconds(3));
+    XCTAssertThrows(duration_histogram::bucket_upper_bound(duration_histogram::bucket_count));
+}
+
+- (void)test_histogram {
+    duration_histogram histogram;
+
+    XCTAssertEqual(histogram.count(), 0);
+    XCTAssertEqual(histogram.percentile(0.5), std::chrono::nanoseconds::zero());
+
+    for (int idx = 0; idx < 90; ++idx) {
+        histogram.record(std::chrono::nanoseconds(100));
+    }
+    for (int idx = 0; idx < 10; ++idx) {
+        histogram.record(std::chrono::microseconds(10));
+    }
+
+    XCTAssertEqual(histogram.count(), 100);
+    XCTAssertEqual(histogram.count_at(duration_histogram::bucket_index(std::chrono::nanoseconds(100))), 90);
+    XCTAssertEqual(histogram.total(), std::chrono::nanoseconds(9000) + std::chrono::microseconds(100));
+    XCTAssertEqual(histogram.max(), std::chrono::microseconds(10));
+    XCTAssertEqual(histogram.percentile(0.5), std::chrono::nanoseconds(127));
+    XCTAssertEqual(histogram.percentile(0.99), std::chrono::microseconds(10));
+    XCTAssertThrows(histogram.percentile(1.5));
+
+    histogram.reset();
+
+    XCTAssertEqual(histogram.count(), 0);
+    XCTAssertEqual(histogram.max(), std::chrono::nanoseconds::zero());
+}
+
+- (void)test_task_queue_metrics {
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    XCTAssertEqual(metrics->priority_count(), 2);
+
+    metrics->add_queue_depth(3);
+    metrics->subtract_queue_depth(2);
+    metrics->add_cancellation_count(4);
+    metrics->record_waiting(1, std::chrono::nanoseconds(10));
+    metrics->record_execution(0, std::chrono::nanoseconds(20));
+
+    XCTAssertEqual(metrics->queue_depth(), 1);
+    XCTAssertEqual(metrics->max_queue_depth(), 3);
+    XCTAssertEqual(metrics->cancellation_count(), 4);
+    XCTAssertEqual(metrics->waiting(1).count(), 1);
+    XCTAssertEqual(metrics->execution(0).count(), 1);
+    XCTAssertThrows(metrics->waiting(2));
+    XCTAssertThrows(task_queue_metrics::make_shared(0));
+}
+
+- (void)test_worker_metrics {
+    auto const metrics = worker_metrics::make_shared();
+
+    XCTAssertEqual(metrics->busy_ratio(), 0.0);
+
+    metrics->record_busy(true, std::chrono::nanoseconds(100));
+    metrics->record_busy(false, std::chrono::nanoseconds(200));
+    metrics->record_idle(std::chrono::nanoseconds(700));
+
+    XCTAssertEqual(metrics->processed_count(), 1);
+    XCTAssertEqual(metrics->unprocessed_count(), 1);
+    XCTAssertEqual(metrics->busy_duration(), std::chrono::nanoseconds(300));
+    XCTAssertEqual(metrics->idle_duration(), std::chrono::nanoseconds(700));
+    XCTAssertEqual(metrics->busy_ratio(), 0.3);
+}
+
+@end
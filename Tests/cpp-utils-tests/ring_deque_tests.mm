@@ -0,0 +1,99 @@
+//
+//  ring_deque_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/ring_deque.h>
+
+using namespace yas;
+
+@interface ring_deque_tests : XCTestCase
+
+@end
+
+@implementation ring_deque_tests
+
+- (void)test_push_and_pop {
+    ring_deque<int> deque;
+
+    XCTAssertTrue(deque.empty());
+
+    deque.emplace_back(2);
+    deque.emplace_back(3);
+    deque.emplace_front(1);
+
+    XCTAssertEqual(deque.size(), 3);
+    XCTAssertEqual(deque.front(), 1);
+    XCTAssertEqual(deque.back(), 3);
+    XCTAssertEqual(deque.at(1), 2);
+    XCTAssertThrows(deque.at(3));
+
+    deque.pop_front();
+
+    XCTAssertEqual(deque.front(), 2);
+
+    deque.pop_back();
+
+    XCTAssertEqual(deque.size(), 1);
+    XCTAssertEqual(deque.back(), 2);
+
+    deque.clear();
+
+    XCTAssertTrue(deque.empty());
+    XCTAssertThrows(deque.pop_front());
+}
+
+- (void)test_grow {
+    ring_deque<int> deque(4);
+
+    XCTAssertEqual(deque.capacity(), 4);
+
+    deque.emplace_back(2);
+    deque.emplace_back(3);
+    deque.pop_front();
+    deque.emplace_back(4);
+    deque.emplace_back(5);
+    deque.emplace_front(1);
+    deque.emplace_back(6);
+
+    XCTAssertEqual(deque.capacity(), 8);
+
+    std::vector<int> values;
+    for (auto const &value : deque) {
+        values.emplace_back(value);
+    }
+
+    XCTAssertEqual(values, (std::vector<int>{1, 3, 4, 5, 6}));
+}
+
+- (void)test_not_grow_in_steady_state {
+    ring_deque<int> deque;
+
+    for (int idx = 0; idx < 1000; ++idx) {
+        deque.emplace_back(idx);
+        deque.emplace_back(idx);
+        deque.pop_front();
+        deque.pop_front();
+    }
+
+    XCTAssertEqual(deque.capacity(), 16);
+}
+
+- (void)test_erase_if {
+    ring_deque<int> deque;
+
+    for (int idx = 0; idx < 10; ++idx) {
+        deque.emplace_back(idx);
+    }
+
+    XCTAssertEqual(deque.erase_if([](int const value) { return value % 2 == 0; }), 5);
+
+    std::vector<int> values;
+    for (auto const &value : deque) {
+        values.emplace_back(value);
+    }
+
+    XCTAssertEqual(values, (std::vector<int>{1, 3, 5, 7, 9}));
+}
+
+@end
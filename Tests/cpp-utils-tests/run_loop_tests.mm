@@ -0,0 +1,181 @@
+//
+//  run_loop_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/run_loop.h>
+#import <atomic>
+#import <future>
+#import <stdexcept>
+#import <thread>
+#import <vector>
+
+using namespace yas;
+
+@interface run_loop_tests : XCTestCase
+
+@end
+
+@implementation run_loop_tests
+
+- (void)setUp {
+}
+
+- (void)tearDown {
+}
+
+- (void)test_process_in_posted_order {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called] { called.push_back(1); });
+    loop->execute([&called] { called.push_back(2); });
+    loop->execute([&called] { called.push_back(3); });
+
+    XCTAssertEqual(called.size(), 0);
+
+    XCTAssertEqual(loop->process(), 3);
+    XCTAssertTrue((called == std::vector<int>{1, 2, 3}));
+
+    XCTAssertEqual(loop->process(), 0);
+}
+
+- (void)test_leave_posted_while_processing {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called, &loop] {
+        called.push_back(1);
+        loop->execute([&called] { called.push_back(2); });
+    });
+
+    XCTAssertEqual(loop->process(), 1);
+    XCTAssertTrue((called == std::vector<int>{1}));
+
+    XCTAssertEqual(loop->process(), 1);
+    XCTAssertTrue((called == std::vector<int>{1, 2}));
+}
+
+- (void)test_leave_rest_after_throwing {
+    auto const loop = run_loop::make_shared();
+
+    std::vector<int> called;
+
+    loop->execute([&called, &loop] {
+        called.push_back(1);
+        loop->execute([&called] { called.push_back(4); });
+        throw std::runtime_error("execution thrown");
+    });
+    loop->execute([&called] { called.push_back(2); });
+    loop->execute([&called] { called.push_back(3); });
+
+    XCTAssertThrows(loop->process());
+    XCTAssertTrue((called == std::vector<int>{1}));
+
+    XCTAssertEqual(loop->process(), 3);
+    XCTAssertTrue((called == std::vector<int>{1, 2, 3, 4}));
+}
+
+- (void)test_process_on_other_thread {
+    auto const loop = run_loop::make_shared();
+
+    XCTAssertTrue(loop->is_current());
+
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+
+    std::thread{[&loop, &promise] {
+        bool is_thrown = false;
+
+        try {
+            loop->process();
+        } catch (std::runtime_error const &) {
+            is_thrown = true;
+        }
+
+        promise.set_value(!loop->is_current() && is_thrown);
+    }}.join();
+
+    XCTAssertTrue(future.get());
+}
+
+- (void)test_destroy_without_processing {
+    auto const shared = std::make_shared<int>(0);
+
+    {
+        auto const loop = run_loop::make_shared();
+        loop->execute([shared] { ++*shared; });
+
+        XCTAssertEqual(shared.use_count(), 2);
+    }
+
+    XCTAssertEqual(shared.use_count(), 1);
+    XCTAssertEqual(*shared, 0);
+}
+
+- (void)test_run_until_stop {
+    std::promise<run_loop_ptr> promise;
+    auto future = promise.get_future();
+    std::atomic<std::size_t> count = 0;
+
+    std::thread loop_thread{[&promise] {
+        auto const loop = run_loop::make_shared();
+        promise.set_value(loop);
+        loop->run();
+    }};
+
+    auto const loop = future.get();
+
+    std::size_t const thread_count = 4;
+    std::size_t const post_count = 10000;
+    std::vector<std::thread> threads;
+
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        threads.emplace_back([&loop, &count] {
+            for (std::size_t idx = 0; idx < post_count; ++idx) {
+                loop->execute([&count, &loop] {
+                    if (loop->is_current()) {
+                        ++count;
+                    }
+                });
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::promise<void> done_promise;
+    loop->execute([&done_promise] { done_promise.set_value(); });
+    done_promise.get_future().wait();
+
+    loop->stop();
+    loop_thread.join();
+
+    XCTAssertEqual(count.load(), thread_count * post_count);
+}
+
+- (void)test_stop_before_run {
+    auto const loop = run_loop::make_shared();
+
+    bool is_called = false;
+
+    loop->execute([&is_called] { is_called = true; });
+    loop->stop();
+    loop->run();
+
+    XCTAssertTrue(is_called);
+}
+
+- (void)test_main {
+    auto const main_loop = run_loop::main();
+
+    XCTAssertTrue(main_loop);
+    XCTAssertTrue(main_loop->is_current());
+    XCTAssertThrows(run_loop::set_main(nullptr));
+}
+
+@end
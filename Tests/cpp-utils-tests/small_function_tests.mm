@@ -0,0 +1,87 @@
+//
+//  small_function_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/small_function.h>
+#import <array>
+#import <functional>
+#import <memory>
+
+using namespace yas;
+
+@interface small_function_tests : XCTestCase
+
+@end
+
+@implementation small_function_tests
+
+- (void)test_call {
+    small_function<int(int)> const function = [](int const value) { return value + 1; };
+
+    XCTAssertTrue(function);
+    XCTAssertEqual(function(1), 2);
+}
+
+- (void)test_empty {
+    small_function<void(void)> const function;
+
+    XCTAssertFalse(function);
+    XCTAssertThrows(function());
+
+    small_function<void(void)> const null_function = nullptr;
+
+    XCTAssertFalse(null_function);
+
+    std::function<void(void)> std_function;
+    small_function<void(void)> const from_empty = std_function;
+
+    XCTAssertFalse(from_empty);
+}
+
+- (void)test_inline {
+    int captured = 2;
+    small_function<int(void)> const small = [captured] { return captured; };
+
+    XCTAssertTrue(small.is_inline());
+    XCTAssertEqual(small(), 2);
+
+    std::array<int, 64> array{};
+    array.at(0) = 3;
+    small_function<int(void)> const large = [array] { return array.at(0); };
+
+    XCTAssertFalse(large.is_inline());
+    XCTAssertEqual(large(), 3);
+}
+
+- (void)test_move {
+    auto unique = std::make_unique<int>(4);
+    small_function<int(void)> function = [unique = std::move(unique)] { return *unique; };
+
+    small_function<int(void)> moved = std::move(function);
+
+    XCTAssertFalse(function);
+    XCTAssertEqual(moved(), 4);
+
+    function = std::move(moved);
+
+    XCTAssertFalse(moved);
+    XCTAssertEqual(function(), 4);
+
+    function = nullptr;
+
+    XCTAssertFalse(function);
+}
+
+- (void)test_destroy {
+    auto const shared = std::make_shared<int>(5);
+
+    {
+        small_function<void(void)> const function = [shared] {};
+        XCTAssertEqual(shared.use_count(), 2);
+    }
+
+    XCTAssertEqual(shared.use_count(), 1);
+}
+
+@end
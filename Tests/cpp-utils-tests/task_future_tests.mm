@@ -0,0 +1,203 @@
+//
+//  task_future_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/task_future.h>
+#import <stdexcept>
+#import <thread>
+
+using namespace yas;
+
+namespace yas::test {
+static task_future<int> await_and_add(task_future<int> const future) {
+    int const value = co_await future;
+    co_return value + 1;
+}
+}  // namespace yas::test
+
+@interface task_future_tests : XCTestCase
+
+@end
+
+@implementation task_future_tests
+
+- (void)test_set_value {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    XCTAssertTrue(future.is_valid());
+    XCTAssertEqual(future.status(), task_future_status::pending);
+    XCTAssertFalse(future.is_ready());
+    XCTAssertFalse(promise.is_satisfied());
+
+    promise.set_value(1);
+
+    XCTAssertEqual(future.status(), task_future_status::completed);
+    XCTAssertTrue(promise.is_satisfied());
+    XCTAssertEqual(future.get(), 1);
+
+    XCTAssertThrows(promise.set_value(2));
+}
+
+- (void)test_set_value_void {
+    task_promise<void> promise;
+    auto const future = promise.future();
+
+    promise.set_value();
+
+    XCTAssertEqual(future.status(), task_future_status::completed);
+    XCTAssertNoThrow(future.get());
+}
+
+- (void)test_set_exception {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    promise.set_exception(std::make_exception_ptr(std::logic_error("test")));
+
+    XCTAssertEqual(future.status(), task_future_status::failed);
+    XCTAssertThrowsSpecific(future.get(), std::logic_error);
+}
+
+- (void)test_cancel_by_destruction {
+    task_future<int> future;
+
+    XCTAssertFalse(future.is_valid());
+    XCTAssertThrows(future.status());
+
+    {
+        task_promise<int> promise;
+        future = promise.future();
+    }
+
+    XCTAssertEqual(future.status(), task_future_status::canceled);
+    XCTAssertThrowsSpecific(future.get(), task_canceled_error);
+}
+
+- (void)test_cancel_by_destruction_with_throwing_continuation {
+    task_future<int> future;
+    std::vector<int> called;
+
+    {
+        task_promise<int> promise;
+        future = promise.future();
+
+        future.on_completed([](auto const &) { throw std::runtime_error("continuation thrown"); });
+        future.on_completed([&called](auto const &) { called.push_back(1); });
+    }
+
+    XCTAssertEqual(future.status(), task_future_status::canceled);
+    XCTAssertTrue((called == std::vector<int>{1}));
+}
+
+- (void)test_on_completed {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    std::vector<int> called;
+
+    future.on_completed([&called](auto const &future) { called.push_back(future.get()); });
+    future.on_completed([&called](auto const &future) { called.push_back(future.get() * 10); });
+
+    XCTAssertEqual(called.size(), 0);
+
+    promise.set_value(1);
+
+    XCTAssertEqual(called, (std::vector<int>{1, 10}));
+
+    future.on_completed([&called](auto const &future) { called.push_back(future.get() * 100); });
+
+    XCTAssertEqual(called, (std::vector<int>{1, 10, 100}));
+}
+
+- (void)test_on_completed_throwing {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    std::vector<int> called;
+
+    future.on_completed([](auto const &) { throw std::runtime_error("continuation thrown"); });
+    future.on_completed([&called](auto const &future) { called.push_back(future.get()); });
+
+    XCTAssertThrows(promise.set_value(1));
+    XCTAssertTrue((called == std::vector<int>{1}));
+    XCTAssertEqual(future.get(), 1);
+}
+
+- (void)test_wait {
+    task_promise<int> promise;
+    auto const future = promise.future();
+
+    XCTAssertFalse(future.wait_for(std::chrono::milliseconds(1)));
+
+    std::thread thread{[promise = std::move(promise)]() mutable { promise.set_value(1); }};
+
+    future.wait();
+
+    XCTAssertEqual(future.get(), 1);
+
+    thread.join();
+}
+
+- (void)test_when_all {
+    task_promise<int> promise0;
+    task_promise<int> promise1;
+
+    auto const future = when_all(std::vector<task_future<int>>{promise0.future(), promise1.future()});
+
+    XCTAssertFalse(future.is_ready());
+
+    promise1.set_value(1);
+
+    XCTAssertFalse(future.is_ready());
+
+    promise0.cancel();
+
+    XCTAssertEqual(future.status(), task_future_status::completed);
+
+    XCTAssertTrue(when_all(std::vector<task_future<int>>{}).is_ready());
+}
+
+- (void)test_when_any {
+    task_promise<int> promise0;
+    task_promise<int> promise1;
+
+    auto const future = when_any(std::vector<task_future<int>>{promise0.future(), promise1.future()});
+
+    XCTAssertFalse(future.is_ready());
+
+    promise1.set_value(1);
+
+    XCTAssertEqual(future.get(), 1);
+
+    promise0.set_value(0);
+
+    XCTAssertEqual(future.get(), 1);
+
+    XCTAssertThrows(when_any(std::vector<task_future<int>>{}));
+}
+
+- (void)test_coroutine {
+    task_promise<int> promise;
+
+    auto const future = test::await_and_add(promise.future());
+
+    XCTAssertFalse(future.is_ready());
+
+    promise.set_value(1);
+
+    XCTAssertEqual(future.get(), 2);
+}
+
+- (void)test_coroutine_canceled {
+    task_promise<int> promise;
+
+    auto const future = test::await_and_add(promise.future());
+
+    promise.cancel();
+
+    XCTAssertEqual(future.status(), task_future_status::canceled);
+}
+
+@end
@@ -3,6 +3,7 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <cpp-utils/pool_allocator.h>
 #import <cpp-utils/task_queue.h>
 #import <future>
 #import <thread>
@@ -10,6 +11,34 @@
 using namespace std::chrono_literals;
 using namespace yas;
 
+namespace yas::test {
+static task_future<int> schedule_and_submit(std::shared_ptr<task_queue<int>> const queue, std::vector<int> &called) {
+    called.push_back(1);
+
+    co_await queue->schedule(0);
+
+    called.push_back(2);
+
+    int const value = co_await queue->submit([](auto const &) { return 10; });
+
+    called.push_back(3);
+
+    co_return value + 1;
+}
+
+static task_future<void> schedule_with_canceller(std::shared_ptr<task_queue<int>> const queue,
+                                                 std::vector<int> &called) {
+    co_await queue->schedule({.canceller = 1});
+
+    called.push_back(1);
+}
+
+// holds the queue without retaining it, so that the queue can be released while the coroutine is suspended.
+static task_future<void> schedule_without_retaining(task_queue<int> *const queue) {
+    co_await queue->schedule(0);
+}
+}  // namespace yas::test
+
 @interface task_queue_tests : XCTestCase
 
 @end
@@ -395,4 +424,756 @@ using namespace yas;
     XCTAssertFalse(queue->is_operating());
 }
 
+- (void)test_executor {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    int called = 0;
+
+    queue->push_back(task<int>::make_shared([&called](auto const &) { ++called; }));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { ++called; }));
+
+    XCTAssertEqual(executor->execution_count(), 1);
+    XCTAssertEqual(called, 0);
+
+    executor->process();
+
+    XCTAssertEqual(called, 1);
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertEqual(called, 2);
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_concurrency {
+    auto const queue = task_queue<int>::make_shared(1, 2);
+
+    XCTAssertEqual(queue->concurrency(), 2);
+
+    std::promise<void> promise_1;
+    std::promise<void> promise_2;
+    auto future_1 = promise_1.get_future();
+    auto future_2 = promise_2.get_future();
+
+    queue->push_back(task<int>::make_shared([&promise_1, &future_2](auto const &) {
+        promise_1.set_value();
+        future_2.get();
+    }));
+    queue->push_back(task<int>::make_shared([&promise_2, &future_1](auto const &) {
+        future_1.get();
+        promise_2.set_value();
+    }));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_concurrency_priority_and_cancel {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, 2, executor);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(3); }, {.priority = 1}));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(1); }, {.priority = 0}));
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.emplace_back(2); },
+                                            {.priority = 0, .canceller = 100}));
+
+    queue->resume();
+
+    XCTAssertEqual(executor->execution_count(), 2);
+
+    queue->cancel([](auto const &canceller) { return canceller == 100; });
+
+    executor->process();
+
+    XCTAssertEqual(called, (std::vector<int>{1}));
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertEqual(called, (std::vector<int>{1, 3}));
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_zero_concurrency {
+    XCTAssertThrows(task_queue<int>::make_shared(1, 0));
+}
+
+- (void)test_wait_with_timeout {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    queue->push_back(task<int>::make_shared([&future](auto const &) { future.get(); }));
+
+    XCTAssertFalse(queue->wait_until_all_tasks_are_finished(10ms));
+
+    promise.set_value();
+
+    XCTAssertTrue(queue->wait_until_all_tasks_are_finished(1000ms));
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_wait_failed_by_suspending {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    queue->push_back(task<int>::make_shared([&future](auto const &) { future.get(); }));
+
+    std::thread thread{[&queue] {
+        std::this_thread::sleep_for(10ms);
+        queue->suspend();
+    }};
+
+    XCTAssertThrows(queue->wait_until_all_tasks_are_finished());
+
+    thread.join();
+    queue->resume();
+    promise.set_value();
+    queue->wait_until_all_tasks_are_finished();
+}
+
+- (void)test_push_back_from_many_threads {
+    auto const queue = task_queue<int>::make_shared();
+
+    std::size_t const thread_count = 4;
+    std::size_t const task_count = 100;
+
+    std::atomic<std::size_t> count;
+    count = 0;
+    std::vector<std::size_t> last_indices(thread_count, 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        threads.emplace_back([self, &queue, &count, &last_indices, thread_idx, task_count] {
+            for (std::size_t idx = 1; idx <= task_count; ++idx) {
+                queue->push_back(task<int>::make_shared([self, &count, &last_indices, thread_idx, idx](auto const &) {
+                    XCTAssertEqual(last_indices.at(thread_idx) + 1, idx);
+                    last_indices.at(thread_idx) = idx;
+                    ++count;
+                }));
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertEqual(count.load(), thread_count * task_count);
+}
+
+- (void)test_push_back_same_task_twice {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    int called = 0;
+
+    auto const task = yas::task<int>::make_shared([&called](auto const &) { ++called; });
+
+    queue->push_back(task);
+    queue->push_back(task);
+
+    queue->resume();
+
+    executor->process();
+    executor->process();
+
+    XCTAssertEqual(called, 2);
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_task_is_pooled {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->push_back(task<int>::make_shared([](auto const &) {}));
+    executor->process();
+
+    auto const &pool = pool_allocator<task<int>>::pool_t::shared();
+    std::size_t const heap_block_count = pool.heap_block_count();
+
+    for (int idx = 0; idx < 10; ++idx) {
+        queue->push_back(task<int>::make_shared([](auto const &) {}));
+        executor->process();
+    }
+
+    XCTAssertEqual(pool.heap_block_count(), heap_block_count);
+}
+
+- (void)test_cancel_by_canceller {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    int called = 0;
+
+    auto const task_1 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 1});
+    auto const task_2 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 2});
+    auto const task_3 = task<int>::make_shared([&called](auto const &) { ++called; }, {.canceller = 1});
+
+    queue->push_back(task_1);
+    queue->push_back(task_2);
+    queue->push_back(task_3);
+
+    queue->cancel_by_canceller(1);
+
+    XCTAssertTrue(task_1->is_canceled());
+    XCTAssertFalse(task_2->is_canceled());
+    XCTAssertTrue(task_3->is_canceled());
+
+    queue->resume();
+
+    executor->process();
+
+    XCTAssertEqual(called, 1);
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_cancel_by_canceller_current_task {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    bool called = false;
+
+    auto const task = yas::task<int>::make_shared([&called](auto const &) { called = true; }, {.canceller = 300});
+
+    queue->push_back(task);
+
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    queue->cancel_by_canceller(300);
+
+    executor->process();
+
+    XCTAssertTrue(task->is_canceled());
+    XCTAssertFalse(called);
+}
+
+- (void)test_cancel_task_not_in_queue {
+    auto const queue = task_queue<int>::make_shared();
+
+    queue->suspend();
+
+    auto const queued_task = task<int>::make_shared([](auto const &) {});
+    auto const other_task = task<int>::make_shared([](auto const &) {});
+
+    queue->push_back(queued_task);
+
+    queue->cancel(other_task);
+
+    XCTAssertFalse(other_task->is_canceled());
+    XCTAssertFalse(queued_task->is_canceled());
+}
+
+- (void)test_metrics {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, executor);
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    XCTAssertFalse(queue->metrics());
+    XCTAssertThrows(queue->set_metrics(task_queue_metrics::make_shared(1)));
+
+    queue->set_metrics(metrics);
+
+    XCTAssertEqual(queue->metrics(), metrics);
+
+    queue->suspend();
+
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 0}));
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 1, .canceller = 1}));
+    queue->push_back(task<int>::make_shared([](auto const &) {}, {.priority = 1}));
+
+    XCTAssertEqual(metrics->queue_depth(), 3);
+    XCTAssertEqual(metrics->max_queue_depth(), 3);
+
+    queue->cancel_by_canceller(1);
+
+    XCTAssertEqual(metrics->cancellation_count(), 1);
+
+    queue->resume();
+
+    executor->process();
+    executor->process();
+
+    XCTAssertEqual(metrics->queue_depth(), 0);
+    XCTAssertEqual(metrics->waiting(0).count(), 1);
+    XCTAssertEqual(metrics->execution(0).count(), 1);
+    XCTAssertEqual(metrics->waiting(1).count(), 1);
+    XCTAssertEqual(metrics->execution(1).count(), 1);
+}
+
+- (void)test_metrics_cancellation_count {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const metrics = task_queue_metrics::make_shared(1);
+
+    queue->set_metrics(metrics);
+    queue->set_batch_size(2);
+    queue->suspend();
+
+    auto const canceled_task = task<int>::make_shared([](auto const &) {}, {.canceller = 1});
+    queue->push_back(canceled_task);
+    queue->push_back(task<int>::make_shared([](auto const &) {}));
+
+    queue->cancel(canceled_task);
+    queue->cancel(canceled_task);
+    queue->cancel_by_canceller(1);
+
+    XCTAssertEqual(metrics->cancellation_count(), 1);
+
+    queue->cancel_all();
+
+    XCTAssertEqual(metrics->cancellation_count(), 2);
+
+    // the finished task of a batch is not counted while the batch is executing.
+    auto const finished_task = task<int>::make_shared([](auto const &) {});
+    queue->push_back(finished_task);
+    queue->push_back(task<int>::make_shared([&queue, &finished_task](auto const &) {
+        queue->cancel(finished_task);
+        queue->cancel_all();
+    }));
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(metrics->cancellation_count(), 3);
+}
+
+- (void)test_deadline {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const metrics = task_queue_metrics::make_shared(1);
+    auto const now = std::chrono::steady_clock::now();
+
+    queue->set_metrics(metrics);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const expired_task =
+        task<int>::make_shared([&called](auto const &) { called.push_back(1); }, {.deadline = now});
+    queue->push_back(expired_task);
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.push_back(2); },
+                                            {.deadline = now + std::chrono::seconds(10)}));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    queue->resume();
+
+    XCTAssertTrue(expired_task->is_canceled());
+    XCTAssertEqual(metrics->expiration_count(), 1);
+
+    executor->process();
+
+    XCTAssertEqual(called, (std::vector<int>{2}));
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_earliest_deadline_first {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+    auto const now = std::chrono::steady_clock::now();
+
+    XCTAssertEqual(queue->ordering(), task_queue_ordering::fifo);
+
+    queue->set_ordering(task_queue_ordering::earliest_deadline_first);
+
+    XCTAssertEqual(queue->ordering(), task_queue_ordering::earliest_deadline_first);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, std::optional<std::chrono::steady_clock::time_point> deadline) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.deadline = deadline});
+    };
+
+    queue->push_back(make_task(1, std::nullopt));
+    queue->push_back(make_task(2, now + std::chrono::seconds(30)));
+    queue->push_back(make_task(3, now + std::chrono::seconds(10)));
+    queue->push_back(make_task(4, now + std::chrono::seconds(20)));
+    queue->push_back(make_task(5, now + std::chrono::seconds(10)));
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{3, 5, 4, 2, 1}));
+}
+
+- (void)test_coalescing {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, int const canceller) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.canceller = canceller, .coalescing = true});
+    };
+
+    auto const current_task = make_task(0, 1);
+    queue->push_back(current_task);
+
+    auto const task1 = make_task(1, 1);
+    auto const task2 = make_task(2, 2);
+    auto const task3 = make_task(3, 1);
+
+    queue->push_back(task1);
+    queue->push_back(task2);
+    queue->push_back(task3);
+
+    XCTAssertFalse(current_task->is_canceled());
+    XCTAssertTrue(task1->is_canceled());
+    XCTAssertFalse(task2->is_canceled());
+    XCTAssertFalse(task3->is_canceled());
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{0, 2, 3}));
+}
+
+- (void)test_coalescing_with_capacity {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::reject);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, int const canceller) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.canceller = canceller, .coalescing = true});
+    };
+
+    auto const task1 = make_task(1, 1);
+
+    XCTAssertEqual(queue->push_back(task1), task_push_result::pushed);
+    XCTAssertEqual(queue->push_back(make_task(2, 2)), task_push_result::pushed);
+
+    // the replaced task releases its room.
+    XCTAssertEqual(queue->push_back(make_task(3, 1)), task_push_result::pushed);
+    XCTAssertTrue(task1->is_canceled());
+    XCTAssertEqual(queue->push_back(make_task(4, 3)), task_push_result::rejected);
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{2, 3}));
+}
+
+- (void)test_batch {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, 2, executor);
+
+    XCTAssertEqual(queue->batch_size(), 1);
+    XCTAssertThrows(queue->set_batch_size(0));
+
+    queue->set_batch_size(3);
+
+    XCTAssertEqual(queue->batch_size(), 3);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    for (int idx = 0; idx < 5; ++idx) {
+        queue->push_back(task<int>::make_shared([&called, idx](auto const &) { called.push_back(idx); }));
+    }
+    queue->push_back(task<int>::make_shared([&called](auto const &) { called.push_back(10); }, {.priority = 1}));
+
+    queue->resume();
+
+    XCTAssertEqual(executor->execution_count(), 2);
+
+    executor->process();
+
+    XCTAssertEqual(called, (std::vector<int>{0, 1, 2, 3, 4}));
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertEqual(called, (std::vector<int>{0, 1, 2, 3, 4, 10}));
+    XCTAssertFalse(queue->is_operating());
+}
+
+- (void)test_submit {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    auto const value_future = queue->submit([](auto const &) { return 1; });
+    auto const void_future = queue->submit([](auto const &) {});
+    auto const failed_future = queue->submit([](auto const &) -> int { throw std::logic_error("test"); });
+    auto const canceled_future = queue->submit([](auto const &) { return 2; }, {.canceller = 1});
+
+    queue->cancel_by_canceller(1);
+
+    XCTAssertEqual(value_future.status(), task_future_status::pending);
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(value_future.get(), 1);
+    XCTAssertEqual(void_future.status(), task_future_status::completed);
+    XCTAssertEqual(failed_future.status(), task_future_status::failed);
+    XCTAssertEqual(canceled_future.status(), task_future_status::canceled);
+}
+
+- (void)test_schedule {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    std::vector<int> called;
+
+    auto const future = test::schedule_and_submit(queue, called);
+
+    XCTAssertEqual(called, (std::vector<int>{1}));
+    XCTAssertFalse(future.is_ready());
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{1, 2, 3}));
+    XCTAssertEqual(future.get(), 11);
+
+    XCTAssertThrows((void)queue->schedule(1));
+}
+
+- (void)test_schedule_canceled {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const future = test::schedule_with_canceller(queue, called);
+
+    queue->cancel_by_canceller(1);
+    queue->cancel_all();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called.size(), 0);
+    XCTAssertEqual(future.status(), task_future_status::canceled);
+}
+
+- (void)test_schedule_canceled_by_releasing_queue {
+    auto queue = task_queue<int>::make_shared();
+
+    std::promise<void> started_promise;
+    std::promise<void> gate_promise;
+    auto started_future = started_promise.get_future();
+    auto gate_future = gate_promise.get_future().share();
+
+    queue->push_back(task<int>::make_shared([&started_promise, gate_future](auto const &) {
+        started_promise.set_value();
+        gate_future.wait();
+    }));
+
+    started_future.get();
+
+    auto const future = test::schedule_without_retaining(queue.get());
+
+    XCTAssertFalse(future.is_ready());
+
+    // the executing task retains the queue, so the queue and its executor are released on the executor thread after
+    // the coroutine is canceled.
+    queue = nullptr;
+    gate_promise.set_value();
+
+    XCTAssertTrue(future.wait_for(1000ms));
+    XCTAssertEqual(future.status(), task_future_status::canceled);
+}
+
+- (void)test_capacity_reject {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(2, executor);
+    auto const metrics = task_queue_metrics::make_shared(2);
+
+    queue->set_metrics(metrics);
+
+    XCTAssertFalse(queue->capacity(0).has_value());
+    XCTAssertEqual(queue->overflow_policy(0), task_queue_overflow_policy::block);
+    XCTAssertThrows(queue->set_capacity(0, 0));
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::reject);
+
+    XCTAssertEqual(queue->capacity(0), 2);
+    XCTAssertEqual(queue->overflow_policy(0), task_queue_overflow_policy::reject);
+
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value, task_priority_t const priority) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); },
+                                      {.priority = priority});
+    };
+
+    XCTAssertEqual(queue->push_back(make_task(1, 0)), task_push_result::pushed);
+    XCTAssertEqual(queue->push_back(make_task(2, 0)), task_push_result::pushed);
+
+    auto const rejected_task = make_task(3, 0);
+
+    XCTAssertEqual(queue->push_back(rejected_task), task_push_result::rejected);
+    XCTAssertFalse(rejected_task->is_canceled());
+    XCTAssertEqual(queue->push_back(make_task(10, 1)), task_push_result::pushed);
+    XCTAssertEqual(metrics->overflow_count(), 1);
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{1, 2, 10}));
+}
+
+- (void)test_capacity_drop {
+    auto const executor = executor_stub::make_shared();
+    auto const queue = task_queue<int>::make_shared(1, executor);
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::drop_oldest);
+    queue->suspend();
+
+    std::vector<int> called;
+
+    auto const make_task = [&called](int const value) {
+        return task<int>::make_shared([&called, value](auto const &) { called.push_back(value); });
+    };
+
+    auto const oldest_task = make_task(1);
+
+    queue->push_back(oldest_task);
+    queue->push_back(make_task(2));
+
+    XCTAssertEqual(queue->push_back(make_task(3)), task_push_result::dropped_oldest);
+    XCTAssertTrue(oldest_task->is_canceled());
+
+    queue->set_capacity(0, 2, task_queue_overflow_policy::drop_newest);
+
+    auto const newest_task = make_task(4);
+
+    XCTAssertEqual(queue->push_front(newest_task), task_push_result::dropped_newest);
+    XCTAssertTrue(newest_task->is_canceled());
+
+    queue->resume();
+
+    while (executor->execution_count() > 0) {
+        executor->process();
+    }
+
+    XCTAssertEqual(called, (std::vector<int>{2, 3}));
+}
+
+- (void)test_capacity_block {
+    auto const queue = task_queue<int>::make_shared(1, 1);
+
+    queue->set_capacity(0, 1);
+
+    std::promise<void> gate_promise;
+    auto gate_future = gate_promise.get_future().share();
+    std::atomic<int> count = 0;
+
+    queue->push_back(task<int>::make_shared([gate_future](auto const &) { gate_future.wait(); }));
+
+    std::this_thread::sleep_for(10ms);
+
+    queue->push_back(task<int>::make_shared([&count](auto const &) { ++count; }));
+
+    XCTAssertEqual(queue->try_push(task<int>::make_shared([&count](auto const &) { ++count; })),
+                   task_push_result::rejected);
+
+    std::atomic<bool> is_pushed = false;
+
+    std::thread thread{[&queue, &count, &is_pushed] {
+        queue->push_back(task<int>::make_shared([&count](auto const &) { ++count; }));
+        is_pushed = true;
+    }};
+
+    std::this_thread::sleep_for(10ms);
+
+    XCTAssertFalse(is_pushed);
+
+    gate_promise.set_value();
+    thread.join();
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertTrue(is_pushed);
+    XCTAssertEqual(count, 2);
+}
+
+- (void)test_capacity_on_concurrent_producers {
+    std::size_t const thread_count = 4;
+    std::size_t const task_count = 100;
+    std::size_t const capacity = 4;
+
+    for (auto const policy : {task_queue_overflow_policy::reject, task_queue_overflow_policy::drop_oldest}) {
+        auto const queue = task_queue<int>::make_shared(1, 1);
+
+        queue->set_capacity(0, capacity, policy);
+        queue->suspend();
+
+        auto const count = std::make_shared<std::atomic<std::size_t>>(0);
+        std::atomic<std::size_t> pushed_count = 0;
+        std::vector<std::thread> threads;
+
+        for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+            threads.emplace_back([&queue, &pushed_count, count] {
+                for (std::size_t idx = 0; idx < task_count; ++idx) {
+                    auto const result = queue->push_back(task<int>::make_shared([count](auto const &) { ++*count; }));
+                    if (result == task_push_result::pushed) {
+                        ++pushed_count;
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        queue->resume();
+        queue->wait_until_all_tasks_are_finished();
+
+        if (policy == task_queue_overflow_policy::reject) {
+            XCTAssertEqual(pushed_count, capacity);
+        }
+        XCTAssertEqual(*count, capacity);
+    }
+}
+
 @end
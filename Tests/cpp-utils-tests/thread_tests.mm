@@ -5,6 +5,7 @@
 #import <XCTest/XCTest.h>
 #import <cpp-utils/thread.h>
 #import <future>
+#import <stdexcept>
 
 using namespace yas;
 
@@ -81,4 +82,18 @@ using namespace yas;
     [self waitForExpectations:@[main_expectation, bg_expectation] timeout:10.0 enforceOrder:YES];
 }
 
+- (void)test_perform_sync_on_main_throwing {
+    auto expectation = [self expectationWithDescription:@""];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), [&expectation] {
+        try {
+            thread::perform_sync_on_main([] { throw std::runtime_error("handler thrown"); });
+        } catch (std::runtime_error const &) {
+            [expectation fulfill];
+        }
+    });
+
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
 @end
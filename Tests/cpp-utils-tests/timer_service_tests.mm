@@ -0,0 +1,142 @@
+//
+//  timer_service_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/timer_service.h>
+#import <atomic>
+#import <future>
+#import <thread>
+
+using namespace yas;
+using namespace std::chrono_literals;
+
+@interface timer_service_tests : XCTestCase
+
+@end
+
+@implementation timer_service_tests
+
+- (void)test_schedule {
+    auto const service = timer_service::make_shared();
+
+    std::promise<bool> promise;
+    auto const begin = std::chrono::steady_clock::now();
+
+    service->schedule(10ms, [&promise, &service] { promise.set_value(service->is_service_thread()); });
+
+    XCTAssertEqual(service->timer_count(), 1);
+
+    auto future = promise.get_future();
+    XCTAssertTrue(future.wait_for(10s) == std::future_status::ready);
+    XCTAssertTrue(future.get());
+    XCTAssertTrue(std::chrono::steady_clock::now() - begin >= 10ms);
+    XCTAssertFalse(service->is_service_thread());
+}
+
+- (void)test_order {
+    auto const service = timer_service::make_shared();
+
+    std::vector<int> called;
+    std::promise<void> promise;
+
+    service->schedule(30ms, [&called, &promise] {
+        called.push_back(3);
+        promise.set_value();
+    });
+    service->schedule(10ms, [&called] { called.push_back(1); });
+    service->schedule(20ms, [&called] { called.push_back(2); });
+
+    XCTAssertTrue(promise.get_future().wait_for(10s) == std::future_status::ready);
+    XCTAssertTrue((called == std::vector<int>{1, 2, 3}));
+    XCTAssertEqual(service->timer_count(), 0);
+}
+
+- (void)test_cancel {
+    auto const service = timer_service::make_shared();
+
+    std::atomic<int> count = 0;
+
+    auto const timer_id = service->schedule(20ms, [&count] { ++count; });
+
+    XCTAssertTrue(service->cancel(timer_id));
+    XCTAssertFalse(service->cancel(timer_id));
+    XCTAssertEqual(service->timer_count(), 0);
+
+    std::this_thread::sleep_for(50ms);
+
+    XCTAssertEqual(count.load(), 0);
+}
+
+- (void)test_repeating {
+    auto const service = timer_service::make_shared();
+
+    std::atomic<int> count = 0;
+    timer_id self_id;
+    std::promise<bool> promise;
+
+    self_id = service->schedule_repeating(5ms, [&count, &service, &self_id, &promise] {
+        if (++count == 3) {
+            promise.set_value(service->cancel(self_id));
+        }
+    });
+
+    auto future = promise.get_future();
+    XCTAssertTrue(future.wait_for(10s) == std::future_status::ready);
+    XCTAssertTrue(future.get());
+
+    std::this_thread::sleep_for(30ms);
+
+    XCTAssertEqual(count.load(), 3);
+    XCTAssertEqual(service->timer_count(), 0);
+    XCTAssertThrows(service->schedule_repeating(0us, [] {}));
+}
+
+- (void)test_cancel_waits_for_handler {
+    auto const service = timer_service::make_shared();
+
+    std::promise<void> started;
+    std::atomic<bool> is_finished = false;
+
+    auto const timer_id = service->schedule(0us, [&started, &is_finished] {
+        started.set_value();
+        std::this_thread::sleep_for(50ms);
+        is_finished = true;
+    });
+
+    started.get_future().wait();
+
+    // the timer firing once is already finished.
+    XCTAssertFalse(service->cancel(timer_id));
+    XCTAssertTrue(is_finished);
+}
+
+- (void)test_many_timers {
+    auto const service = timer_service::make_shared();
+
+    std::size_t const timer_count = 100000;
+    std::atomic<std::size_t> fired_count = 0;
+    std::vector<timer_id> timer_ids;
+    timer_ids.reserve(timer_count);
+
+    for (std::size_t idx = 0; idx < timer_count; ++idx) {
+        timer_ids.push_back(service->schedule(std::chrono::microseconds(idx % 20000), [&fired_count] { ++fired_count; }));
+    }
+
+    std::size_t canceled_count = 0;
+    for (std::size_t idx = 0; idx < timer_count; idx += 2) {
+        if (service->cancel(timer_ids.at(idx))) {
+            ++canceled_count;
+        }
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + 10s;
+    while (service->timer_count() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    XCTAssertEqual(service->timer_count(), 0);
+    XCTAssertEqual(fired_count.load() + canceled_count, timer_count);
+}
+
+@end
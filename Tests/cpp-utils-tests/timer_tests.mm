@@ -5,7 +5,9 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <cpp-utils/thread.h>
 #import <cpp-utils/timer.h>
+#import <atomic>
 
 using namespace yas;
 
@@ -99,4 +101,39 @@ using namespace yas;
     XCTAssertGreaterThan(count_all, 1);
 }
 
+- (void)test_default_delivery_is_main {
+    XCTAssertEqual(timer::default_delivery, timer_delivery::main);
+
+    XCTestExpectation *exp = [self expectationWithDescription:@"timer"];
+
+    bool is_main = false;
+
+    auto timer = yas::timer(0.1, false, [exp, &is_main]() {
+        is_main = thread::is_main();
+        [exp fulfill];
+    });
+
+    [self waitForExpectations:@[exp] timeout:10.0];
+
+    XCTAssertTrue(is_main);
+}
+
+- (void)test_service_delivery {
+    XCTestExpectation *exp = [self expectationWithDescription:@"timer"];
+
+    std::atomic<bool> is_main = true;
+
+    auto timer = yas::timer(
+        0.1, false,
+        [exp, &is_main]() {
+            is_main = thread::is_main();
+            [exp fulfill];
+        },
+        timer_delivery::service);
+
+    [self waitForExpectations:@[exp] timeout:10.0];
+
+    XCTAssertFalse(is_main.load());
+}
+
 @end
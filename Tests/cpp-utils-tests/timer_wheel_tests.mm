@@ -0,0 +1,143 @@
+//
+//  timer_wheel_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/timer_wheel.h>
+#import <algorithm>
+#import <map>
+#import <random>
+
+using namespace yas;
+
+@interface timer_wheel_tests : XCTestCase
+
+@end
+
+@implementation timer_wheel_tests
+
+- (void)test_advance {
+    timer_wheel wheel;
+
+    wheel.insert(1, 300);
+    wheel.insert(2, 5);
+    wheel.insert(3, 70000);
+
+    XCTAssertEqual(wheel.size(), 3);
+    XCTAssertEqual(wheel.next_deadline().value(), 5);
+
+    std::vector<timer_wheel::index_t> expired;
+
+    wheel.advance(4, expired);
+
+    XCTAssertTrue(expired.empty());
+    XCTAssertEqual(wheel.elapsed(), 4);
+
+    wheel.advance(1000000, expired);
+
+    XCTAssertTrue((expired == std::vector<timer_wheel::index_t>{2, 1, 3}));
+    XCTAssertEqual(wheel.size(), 0);
+    XCTAssertFalse(wheel.next_deadline().has_value());
+}
+
+- (void)test_remove {
+    timer_wheel wheel;
+
+    wheel.insert(0, 10);
+    wheel.insert(1, 10);
+
+    XCTAssertTrue(wheel.remove(0));
+    XCTAssertFalse(wheel.remove(0));
+    XCTAssertFalse(wheel.remove(100));
+    XCTAssertFalse(wheel.contains(0));
+    XCTAssertTrue(wheel.contains(1));
+
+    std::vector<timer_wheel::index_t> expired;
+    wheel.advance(10, expired);
+
+    XCTAssertTrue((expired == std::vector<timer_wheel::index_t>{1}));
+}
+
+- (void)test_insert_elapsed {
+    timer_wheel wheel;
+
+    std::vector<timer_wheel::index_t> expired;
+    wheel.advance(100, expired);
+
+    wheel.insert(0, 50);
+
+    XCTAssertEqual(wheel.next_deadline().value(), 100);
+
+    wheel.advance(100, expired);
+
+    XCTAssertTrue((expired == std::vector<timer_wheel::index_t>{0}));
+}
+
+- (void)test_distant_deadline {
+    timer_wheel wheel;
+
+    timer_wheel::tick_t const distant = (timer_wheel::tick_t{1} << 52) + 12345;
+
+    wheel.insert(0, distant);
+    wheel.insert(1, 1000);
+
+    std::vector<timer_wheel::index_t> expired;
+
+    wheel.advance(distant - 1, expired);
+
+    XCTAssertTrue((expired == std::vector<timer_wheel::index_t>{1}));
+
+    wheel.advance(distant, expired);
+
+    XCTAssertTrue((expired == std::vector<timer_wheel::index_t>{1, 0}));
+}
+
+- (void)test_random {
+    std::mt19937_64 engine{0};
+    timer_wheel wheel;
+    std::map<timer_wheel::index_t, timer_wheel::tick_t> deadlines;
+    timer_wheel::tick_t now = 0;
+
+    auto const random_delay = [&engine] {
+        timer_wheel::tick_t const ranges[] = {10, 1000, 100000, 100000000, timer_wheel::tick_t{1} << 55};
+        return engine() % ranges[engine() % std::size(ranges)];
+    };
+
+    for (std::size_t step = 0; step < 100000; ++step) {
+        auto const op = engine() % 10;
+
+        if (op < 5) {
+            auto const idx = static_cast<timer_wheel::index_t>(engine() % 500);
+            auto const deadline = now + random_delay();
+            wheel.insert(idx, deadline);
+            deadlines.insert_or_assign(idx, deadline);
+        } else if (op < 7) {
+            auto const idx = static_cast<timer_wheel::index_t>(engine() % 500);
+            XCTAssertEqual(wheel.remove(idx), deadlines.erase(idx) > 0);
+        } else {
+            auto const next_deadline = wheel.next_deadline();
+            auto const to = (engine() % 3 == 0 && next_deadline) ? *next_deadline : now + random_delay() / 1000;
+
+            std::vector<timer_wheel::index_t> expired;
+            wheel.advance(to, expired);
+
+            std::vector<timer_wheel::index_t> expected;
+            std::erase_if(deadlines, [&expected, &to](auto const &pair) {
+                if (pair.second <= to) {
+                    expected.push_back(pair.first);
+                    return true;
+                }
+                return false;
+            });
+
+            std::sort(expired.begin(), expired.end());
+            XCTAssertTrue(expired == expected);
+
+            now = to;
+        }
+
+        XCTAssertEqual(wheel.size(), deadlines.size());
+    }
+}
+
+@end
@@ -0,0 +1,242 @@
+//
+//  work_stealing_executor_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/task_queue.h>
+#import <cpp-utils/work_stealing_executor.h>
+#import <atomic>
+#import <future>
+#import <mutex>
+#import <set>
+#import <thread>
+
+using namespace yas;
+
+@interface work_stealing_executor_tests : XCTestCase
+
+@end
+
+@implementation work_stealing_executor_tests
+
+- (void)test_make_shared {
+    auto const executor = work_stealing_executor::make_shared(2, 3);
+
+    XCTAssertEqual(executor->thread_count(), 2);
+    XCTAssertEqual(executor->priority_count(), 3);
+
+    XCTAssertGreaterThanOrEqual(work_stealing_executor::make_shared()->thread_count(), 1);
+    XCTAssertThrows(work_stealing_executor::make_shared(1, 0));
+}
+
+- (void)test_execute {
+    auto const executor = work_stealing_executor::make_shared(2);
+
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+
+    executor->execute([&promise, &executor] { promise.set_value(executor->is_executor_thread()); });
+
+    XCTAssertTrue(future.get());
+    XCTAssertFalse(executor->is_executor_thread());
+}
+
+- (void)test_priority {
+    auto const executor = work_stealing_executor::make_shared(1, 3);
+
+    std::promise<void> started_promise;
+    std::promise<void> gate_promise;
+    std::promise<void> end_promise;
+    auto started_future = started_promise.get_future();
+    auto gate_future = gate_promise.get_future();
+    auto end_future = end_promise.get_future();
+
+    std::mutex mutex;
+    std::vector<int> called;
+
+    executor->execute([&started_promise, &gate_future] {
+        started_promise.set_value();
+        gate_future.get();
+    });
+
+    started_future.get();
+
+    executor->execute(2, [&mutex, &called, &end_promise] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            called.push_back(2);
+        }
+        end_promise.set_value();
+    });
+    executor->execute(1, [&mutex, &called] {
+        std::lock_guard<std::mutex> lock(mutex);
+        called.push_back(1);
+    });
+    executor->execute(0, [&mutex, &called] {
+        std::lock_guard<std::mutex> lock(mutex);
+        called.push_back(0);
+    });
+
+    gate_promise.set_value();
+    end_future.get();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssertEqual(called, (std::vector<int>{0, 1, 2}));
+}
+
+- (void)test_continuation_is_executed_last_in_first_out {
+    auto const executor = work_stealing_executor::make_shared(1);
+
+    std::promise<void> end_promise;
+    auto end_future = end_promise.get_future();
+
+    std::mutex mutex;
+    std::vector<int> called;
+
+    executor->execute([&executor, &mutex, &called, &end_promise] {
+        executor->execute([&mutex, &called, &end_promise] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                called.push_back(1);
+            }
+            end_promise.set_value();
+        });
+        executor->execute([&mutex, &called] {
+            std::lock_guard<std::mutex> lock(mutex);
+            called.push_back(2);
+        });
+    });
+
+    end_future.get();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssertEqual(called, (std::vector<int>{2, 1}));
+}
+
+- (void)test_steal {
+    auto const executor = work_stealing_executor::make_shared(4);
+
+    std::promise<void> end_promise;
+    auto end_future = end_promise.get_future();
+
+    std::atomic<int> count = 0;
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+
+    executor->execute([&executor, &count, &mutex, &thread_ids, &end_promise] {
+        for (int idx = 0; idx < 1000; ++idx) {
+            executor->execute([&count, &mutex, &thread_ids, &end_promise] {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    thread_ids.insert(std::this_thread::get_id());
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                if (++count == 1000) {
+                    end_promise.set_value();
+                }
+            });
+        }
+    });
+
+    XCTAssertEqual(end_future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssertGreaterThan(thread_ids.size(), 1);
+}
+
+- (void)test_execute_after {
+    auto const executor = work_stealing_executor::make_shared(2);
+
+    auto const begin = std::chrono::steady_clock::now();
+
+    std::promise<std::chrono::steady_clock::time_point> promise;
+    auto future = promise.get_future();
+
+    executor->execute_after(std::chrono::milliseconds(30), 0,
+                            [&promise] { promise.set_value(std::chrono::steady_clock::now()); });
+
+    XCTAssertGreaterThanOrEqual(future.get() - begin, std::chrono::milliseconds(30));
+}
+
+- (void)test_task_queue {
+    auto const executor = work_stealing_executor::make_shared(4, 2);
+    auto const queue = task_queue<int>::make_shared(2, 4, executor);
+
+    std::atomic<int> count = 0;
+
+    for (uint32_t idx = 0; idx < 1000; ++idx) {
+        queue->push_back(task<int>::make_shared([&count](auto const &) { ++count; }, {.priority = idx % 2}));
+    }
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertEqual(count, 1000);
+}
+
+- (void)test_worker {
+    auto const executor = work_stealing_executor::make_shared(2, 2);
+    auto const worker = work_stealing_worker::make_shared(executor, std::chrono::milliseconds(1));
+
+    std::atomic<int> processed_count = 0;
+    std::atomic<int> unprocessed_count = 0;
+    std::promise<void> end_promise;
+    auto end_future = end_promise.get_future();
+
+    worker->add_task(0, [&processed_count] {
+        return ++processed_count < 100 ? worker_task_result::processed : worker_task_result::completed;
+    });
+    worker->add_task(1, [&unprocessed_count, &end_promise] {
+        if (++unprocessed_count == 5) {
+            end_promise.set_value();
+            return worker_task_result::completed;
+        }
+        return worker_task_result::unprocessed;
+    });
+
+    worker->start();
+
+    XCTAssertThrows(worker->start());
+    XCTAssertThrows(worker->add_task(0, [] { return worker_task_result::completed; }));
+
+    XCTAssertEqual(end_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+
+    XCTAssertEqual(unprocessed_count, 5);
+}
+
+- (void)test_worker_wake {
+    auto const executor = work_stealing_executor::make_shared(1);
+    auto const worker = work_stealing_worker::make_shared(executor, std::chrono::seconds(10));
+
+    std::atomic<bool> has_work = false;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(0, [&has_work, &promise] {
+        if (has_work.exchange(false)) {
+            promise.set_value();
+            return worker_task_result::completed;
+        }
+        return worker_task_result::unprocessed;
+    });
+
+    worker->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    has_work = true;
+    worker->wake();
+
+    XCTAssertEqual(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+}
+
+- (void)test_worker_without_task {
+    auto const worker = work_stealing_worker::make_shared(work_stealing_executor::make_shared(1));
+
+    XCTAssertThrows(worker->start());
+}
+
+@end
@@ -4,6 +4,9 @@
 
 #import <XCTest/XCTest.h>
 #import <cpp-utils/worker.h>
+#import <atomic>
+#import <future>
+#import <thread>
 
 using namespace yas;
 
@@ -165,6 +168,164 @@ struct counter {
     [self waitForExpectations:expectations timeout:10.0 enforceOrder:YES];
 }
 
+- (void)test_wake {
+    auto const worker = worker::make_shared(std::chrono::seconds(10));
+
+    std::atomic<bool> has_work = false;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(0, [&has_work, &promise] {
+        if (has_work.exchange(false)) {
+            promise.set_value();
+            return worker::task_result::completed;
+        }
+        return worker::task_result::unprocessed;
+    });
+
+    worker->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    has_work = true;
+    worker->wake();
+
+    XCTAssertEqual(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+}
+
+- (void)test_insert_task_while_running {
+    auto const worker = worker::make_shared(std::chrono::seconds(10));
+
+    worker->add_task(0, [] { return worker::task_result::unprocessed; });
+
+    worker->start();
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->insert_task(1, [&promise] {
+        promise.set_value();
+        return worker::task_result::completed;
+    });
+
+    XCTAssertEqual(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+}
+
+- (void)test_insert_and_remove_tasks_on_threads {
+    auto const worker = worker::make_shared(std::chrono::milliseconds(1));
+
+    worker->add_task(0, [] { return worker::task_result::unprocessed; });
+
+    worker->start();
+
+    std::size_t constexpr thread_count = 4;
+    std::size_t constexpr task_count = 50;
+
+    auto const called_count = std::make_shared<std::atomic<std::size_t>>(0);
+    std::vector<std::thread> threads;
+
+    for (std::size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        threads.emplace_back([&worker, called_count] {
+            for (std::size_t idx = 0; idx < task_count; ++idx) {
+                auto const removed_id = worker->insert_task(1, [] { return worker::task_result::unprocessed; });
+
+                worker->insert_task(2, [called_count] {
+                    ++*called_count;
+                    return worker::task_result::completed;
+                });
+
+                worker->remove_task(removed_id);
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto const begin = std::chrono::steady_clock::now();
+    while (*called_count < thread_count * task_count &&
+           std::chrono::steady_clock::now() - begin < std::chrono::seconds(10)) {
+        std::this_thread::yield();
+    }
+
+    worker->stop();
+
+    XCTAssertEqual(*called_count, thread_count * task_count);
+}
+
+- (void)test_remove_task {
+    auto const worker = worker::make_shared(std::chrono::milliseconds(1));
+
+    std::atomic<int> removed_count = 0;
+    std::atomic<int> count = 0;
+
+    auto const id = worker->insert_task(0, [&removed_count] {
+        ++removed_count;
+        return worker::task_result::unprocessed;
+    });
+    worker->insert_task(1, [&count] {
+        ++count;
+        return worker::task_result::unprocessed;
+    });
+
+    worker->start();
+
+    while (removed_count == 0) {
+        std::this_thread::yield();
+    }
+
+    worker->remove_task(id);
+
+    int const removed = removed_count;
+    int const prev_count = count;
+
+    while (count < prev_count + 2) {
+        std::this_thread::yield();
+    }
+
+    XCTAssertLessThanOrEqual(removed_count, removed + 1);
+
+    worker->stop();
+}
+
+- (void)test_metrics {
+    auto const worker = worker::make_shared(std::chrono::milliseconds(1));
+    auto const metrics = worker_metrics::make_shared();
+
+    worker->set_metrics(metrics);
+
+    XCTAssertEqual(worker->metrics(), metrics);
+
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    worker->add_task(0, [count = std::make_shared<int>(0), &promise] {
+        if (++*count < 10) {
+            return worker::task_result::processed;
+        } else if (*count == 12) {
+            promise.set_value();
+        }
+        return worker::task_result::unprocessed;
+    });
+
+    worker->start();
+
+    XCTAssertThrows(worker->set_metrics(nullptr));
+
+    XCTAssertEqual(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    worker->stop();
+
+    XCTAssertEqual(metrics->processed_count(), 9);
+    XCTAssertGreaterThanOrEqual(metrics->unprocessed_count(), 2);
+    XCTAssertGreaterThan(metrics->busy_ratio(), 0.0);
+}
+
 - (void)test_stub_all_unprocessed {
     NSMutableArray<XCTestExpectation *> *exps0 = [[NSMutableArray alloc] init];
     NSMutableArray<XCTestExpectation *> *exps1 = [[NSMutableArray alloc] init];
@@ -354,4 +515,15 @@ struct counter {
     XCTAssertEqual(worker->resource_tasks().size(), 2);
 }
 
+- (void)test_stub_wake {
+    auto const worker = worker_stub::make_shared();
+
+    XCTAssertEqual(worker->wake_count(), 0);
+
+    worker->wake();
+    worker->wake();
+
+    XCTAssertEqual(worker->wake_count(), 2);
+}
+
 @end
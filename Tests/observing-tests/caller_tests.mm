@@ -187,4 +187,122 @@ using namespace yas::observing;
     canceller->cancel();
 }
 
+- (void)test_cancel_on_calling {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    canceller_ptr canceller2 = nullptr;
+
+    auto canceller1 = caller->add(0, [&called, &canceller2](int const &value) {
+        called.emplace_back(value);
+        canceller2->cancel();
+    });
+    canceller2 = caller->add(1, [&called](int const &value) { called.emplace_back(value + 100); });
+    auto canceller3 = caller->add(2, [&called](int const &value) { called.emplace_back(value + 200); });
+
+    caller->call(1);
+
+    XCTAssertTrue((called == std::vector<int>{1, 201}));
+
+    canceller1->cancel();
+
+    caller->call(2);
+
+    XCTAssertTrue((called == std::vector<int>{1, 201, 202}));
+}
+
+- (void)test_add_on_calling {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    std::vector<canceller_ptr> cancellers;
+
+    cancellers.emplace_back(caller->add(1, [&caller, &called, &cancellers](int const &value) {
+        called.emplace_back(value);
+
+        if (cancellers.size() == 1) {
+            cancellers.emplace_back(caller->add(0, [&called](int const &value) { called.emplace_back(value + 100); }));
+            cancellers.emplace_back(caller->add(2, [&called](int const &value) { called.emplace_back(value + 200); }));
+        }
+    }));
+
+    // 呼び出し中に追加したハンドラは次のcallから呼ばれる
+    caller->call(1);
+
+    XCTAssertTrue((called == std::vector<int>{1}));
+
+    caller->call(2);
+
+    XCTAssertTrue((called == std::vector<int>{1, 102, 2, 202}));
+}
+
+- (void)test_many_handlers {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::size_t const count = 10000;
+    std::vector<std::size_t> called;
+    std::vector<canceller_ptr> cancellers;
+
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        std::size_t const order = count - 1 - idx;
+        cancellers.emplace_back(caller->add(order, [&called, order](int const &) { called.emplace_back(order); }));
+    }
+
+    for (std::size_t idx = 0; idx < count; idx += 2) {
+        cancellers.at(idx)->cancel();
+    }
+
+    caller->call(0);
+
+    XCTAssertEqual(called.size(), count / 2);
+    XCTAssertTrue(std::is_sorted(called.begin(), called.end()));
+}
+
+- (void)test_move_only_handler {
+    auto caller = observing::caller<int>::make_shared();
+
+    std::vector<int> called;
+    auto offset = std::make_unique<int>(10);
+
+    auto canceller = caller->add(
+        [&called, offset = std::move(offset)](int const &value) { called.emplace_back(value + *offset); });
+
+    caller->call(1);
+
+    XCTAssertTrue((called == std::vector<int>{11}));
+}
+
+- (void)test_queue_recursive_call {
+    auto caller = observing::caller<int>::make_shared(caller_reentrancy::queue);
+
+    XCTAssertEqual(caller->reentrancy(), caller_reentrancy::queue);
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto canceller1 = caller->add(0, [&caller, &called1](int const &value) {
+        called1.emplace_back(value);
+
+        if (value == 0) {
+            caller->call(1);
+            caller->call(2);
+        }
+    });
+    auto canceller2 = caller->add(1, [&called2](int const &value) { called2.emplace_back(value); });
+
+    caller->call(0);
+
+    XCTAssertTrue((called1 == std::vector<int>{0, 1, 2}));
+    XCTAssertTrue((called2 == std::vector<int>{0, 1, 2}));
+}
+
+- (void)test_make_shared_not_queueable {
+    struct referencing {
+        int const &value;
+    };
+
+    XCTAssertEqual(observing::caller<referencing>::make_shared()->reentrancy(), caller_reentrancy::ignore);
+    XCTAssertThrows(observing::caller<referencing>::make_shared(caller_reentrancy::queue));
+}
+
 @end
@@ -0,0 +1,113 @@
+//
+//  concurrent_notifier_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <observing/umbrella.hpp>
+#import <atomic>
+#import <thread>
+
+using namespace yas;
+using namespace yas::observing;
+
+@interface concurrent_notifier_tests : XCTestCase
+
+@end
+
+@implementation concurrent_notifier_tests
+
+- (void)test_notify {
+    auto const notifier = concurrent_notifier<int>::make_shared();
+
+    std::vector<int> called1;
+    std::vector<int> called2;
+
+    auto const canceller1 = notifier->observe([&called1](int const &value) { called1.emplace_back(value); }).end();
+    auto const canceller2 = notifier->observe([&called2](int const &value) { called2.emplace_back(value); }).end();
+
+    XCTAssertEqual(notifier->handler_count(), 2);
+
+    notifier->notify(1);
+
+    XCTAssertTrue((called1 == std::vector<int>{1}));
+    XCTAssertTrue((called2 == std::vector<int>{1}));
+
+    canceller1->cancel();
+
+    XCTAssertEqual(notifier->handler_count(), 1);
+
+    notifier->notify(2);
+
+    XCTAssertTrue((called1 == std::vector<int>{1}));
+    XCTAssertTrue((called2 == std::vector<int>{1, 2}));
+}
+
+- (void)test_observe_with_order {
+    auto const notifier = concurrent_notifier<std::nullptr_t>::make_shared();
+
+    std::vector<int> called;
+
+    auto const canceller1 = notifier->observe(1, [&called](auto const &) { called.emplace_back(1); }).end();
+    auto const canceller2 = notifier->observe(0, [&called](auto const &) { called.emplace_back(0); }).end();
+
+    notifier->notify();
+
+    XCTAssertTrue((called == std::vector<int>{0, 1}));
+}
+
+- (void)test_destruct_notifier {
+    std::vector<int> called;
+    cancellable_ptr canceller = nullptr;
+
+    {
+        auto const notifier = concurrent_notifier<int>::make_shared();
+        canceller = notifier->observe([&called](int const &value) { called.emplace_back(value); }).end();
+        notifier->notify(1);
+    }
+
+    canceller->cancel();
+
+    XCTAssertTrue((called == std::vector<int>{1}));
+}
+
+- (void)test_notify_from_threads {
+    auto const notifier = concurrent_notifier<int>::make_shared();
+
+    std::size_t const notifying_count = 4;
+    std::size_t const notification_count = 10000;
+    std::atomic<std::size_t> stable_count = 0;
+    std::atomic<std::size_t> observing_count = 0;
+    std::atomic<bool> is_notifying = true;
+
+    auto const stable = notifier->observe([&stable_count](int const &) { ++stable_count; }).end();
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t idx = 0; idx < notifying_count; ++idx) {
+        threads.emplace_back([&notifier] {
+            for (std::size_t idx = 0; idx < notification_count; ++idx) {
+                notifier->notify(static_cast<int>(idx));
+            }
+        });
+    }
+
+    std::thread observing_thread{[&notifier, &observing_count, &is_notifying] {
+        while (is_notifying) {
+            auto canceller = notifier->observe([&observing_count](int const &) { ++observing_count; }).end();
+            std::this_thread::yield();
+            canceller->cancel();
+        }
+    }};
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    is_notifying = false;
+    observing_thread.join();
+
+    XCTAssertEqual(stable_count.load(), notifying_count * notification_count);
+    XCTAssertEqual(notifier->handler_count(), 1);
+}
+
+@end
@@ -0,0 +1,275 @@
+//
+//  delivery_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <cpp-utils/executor.h>
+#import <observing/umbrella.hpp>
+#import <future>
+#import <stdexcept>
+
+using namespace yas;
+using namespace yas::observing;
+
+@interface delivery_tests : XCTestCase
+
+@end
+
+@implementation delivery_tests
+
+- (void)test_coalesce {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+
+    auto const delivery = observing::delivery<int>::make_shared(
+        executor, [&called](int const &value) { called.emplace_back(value); });
+
+    delivery->push(1);
+    delivery->push(2);
+    delivery->push(3);
+
+    XCTAssertEqual(called.size(), 0);
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{3}));
+}
+
+- (void)test_cancel {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+
+    auto const delivery = observing::delivery<int>::make_shared(
+        executor, [&called](int const &value) { called.emplace_back(value); });
+
+    delivery->push(1);
+    delivery->cancel();
+
+    XCTAssertTrue(delivery->is_cancelled());
+
+    executor->process();
+
+    XCTAssertEqual(called.size(), 0);
+}
+
+- (void)test_handler_throws {
+    auto const executor = executor_stub::make_shared();
+
+    std::vector<int> called;
+    std::size_t error_count = 0;
+    delivery_ptr<int> delivery = nullptr;
+
+    delivery = observing::delivery<int>::make_shared(
+        executor,
+        [&called, &delivery](int const &value) {
+            called.emplace_back(value);
+
+            if (value == 1) {
+                delivery->push(2);
+                throw std::runtime_error("handler thrown");
+            } else if (value == 3) {
+                throw std::runtime_error("handler thrown");
+            }
+        },
+        [&error_count](std::exception_ptr const &exception) {
+            if (exception) {
+                ++error_count;
+            }
+        });
+
+    delivery->push(1);
+    executor->process();
+
+    XCTAssertEqual(error_count, 1);
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{1, 2}));
+
+    delivery->push(3);
+    executor->process();
+    delivery->push(4);
+
+    XCTAssertEqual(error_count, 2);
+    XCTAssertEqual(executor->execution_count(), 1);
+
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{1, 2, 3, 4}));
+}
+
+- (void)test_handler_throws_on_thread_pool {
+    auto const executor = thread_pool_executor::make_shared(1);
+
+    std::promise<void> promise;
+    delivery_ptr<int> delivery = nullptr;
+
+    delivery = observing::delivery<int>::make_shared(executor, [&delivery, &promise](int const &value) {
+        if (value == 1) {
+            delivery->push(2);
+            throw std::runtime_error("handler thrown");
+        }
+        promise.set_value();
+    });
+
+    delivery->push(1);
+
+    XCTAssertTrue(promise.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+}
+
+- (void)test_release_delivered_value {
+    auto const executor = executor_stub::make_shared();
+
+    auto const delivery =
+        observing::delivery<std::shared_ptr<int>>::make_shared(executor, [](std::shared_ptr<int> const &) {});
+
+    auto first = std::make_shared<int>(1);
+    std::weak_ptr<int> const weak_first = first;
+
+    delivery->push(first);
+    first = nullptr;
+    executor->process();
+
+    XCTAssertTrue(weak_first.expired());
+
+    auto second = std::make_shared<int>(2);
+    std::weak_ptr<int> const weak_second = second;
+
+    delivery->push(second);
+    second = nullptr;
+    executor->process();
+
+    XCTAssertTrue(weak_second.expired());
+}
+
+- (void)test_notifier_observe_on {
+    auto const executor = executor_stub::make_shared();
+    auto const notifier = observing::notifier<int>::make_shared();
+
+    std::vector<int> called;
+
+    auto canceller = notifier->observe_on(executor, [&called](int const &value) { called.emplace_back(value); }).end();
+
+    notifier->notify(1);
+    notifier->notify(2);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{2}));
+
+    notifier->notify(3);
+    canceller->cancel();
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{2}));
+}
+
+- (void)test_value_holder_observe_on {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = value::holder<int>::make_shared(100);
+
+    std::vector<int> called;
+
+    auto canceller = holder->observe_on(executor, [&called](int const &value) { called.emplace_back(value); }).sync();
+
+    holder->set_value(101);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<int>{101}));
+
+    canceller->cancel();
+}
+
+- (void)test_vector_holder_observe_on {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = vector::holder<int>::make_shared({1});
+
+    std::vector<std::vector<int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::vector<int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->push_back(2);
+    holder->erase(0);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<std::vector<int>>{{2}}));
+
+    canceller->cancel();
+}
+
+- (void)test_map_holder_observe_on {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = map::holder<int, int>::make_shared();
+
+    std::vector<std::map<int, int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::map<int, int> const &elements) { called.emplace_back(elements); })
+                         .end();
+
+    holder->insert_or_replace(1, 10);
+    holder->insert_or_replace(2, 20);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<std::map<int, int>>{{{1, 10}, {2, 20}}}));
+
+    canceller->cancel();
+}
+
+- (void)test_vector_holder_observe_on_changes {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = vector::holder<int>::make_shared({1, 2, 3});
+
+    std::vector<std::vector<int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::vector<int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->replace(10, 0);
+    holder->insert(5, 1);
+    holder->push_back(4);
+    holder->erase(2);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<std::vector<int>>{{10, 5, 3, 4}}));
+
+    holder->erase(0);
+    holder->replace(20, 0);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<std::vector<int>>{{10, 5, 3, 4}, {20, 3, 4}}));
+
+    canceller->cancel();
+}
+
+- (void)test_map_holder_observe_on_changes {
+    auto const executor = executor_stub::make_shared();
+    auto const holder = map::holder<int, int>::make_shared({{1, 10}, {2, 20}});
+
+    std::vector<std::map<int, int>> called;
+
+    auto canceller = holder
+                         ->observe_on(executor,
+                                      [&called](std::map<int, int> const &elements) { called.emplace_back(elements); })
+                         .sync();
+
+    holder->insert_or_replace(1, 11);
+    holder->insert_or_replace(3, 30);
+    holder->erase(2);
+    executor->process();
+
+    XCTAssertTrue((called == std::vector<std::map<int, int>>{{{1, 11}, {3, 30}}}));
+
+    canceller->cancel();
+}
+
+@end
@@ -111,4 +111,37 @@ using namespace yas::observing;
     notifier->notify(nullptr);
 }
 
+- (void)test_notify_recursively {
+    auto const ignoring = observing::notifier<int>::make_shared();
+    auto const queueing = observing::notifier<int>::make_shared(caller_reentrancy::queue);
+
+    std::vector<int> ignored;
+    std::vector<int> queued;
+
+    auto const canceller1 = ignoring
+                                ->observe([&ignoring, &ignored](int const &value) {
+                                    ignored.emplace_back(value);
+
+                                    if (value < 2) {
+                                        ignoring->notify(value + 1);
+                                    }
+                                })
+                                .end();
+    auto const canceller2 = queueing
+                                ->observe([&queueing, &queued](int const &value) {
+                                    queued.emplace_back(value);
+
+                                    if (value < 2) {
+                                        queueing->notify(value + 1);
+                                    }
+                                })
+                                .end();
+
+    ignoring->notify(0);
+    queueing->notify(0);
+
+    XCTAssertTrue((ignored == std::vector<int>{0}));
+    XCTAssertTrue((queued == std::vector<int>{0, 1, 2}));
+}
+
 @end